@@ -0,0 +1,113 @@
+/*
+   LoRaLib ADR Example
+
+   This example receives LoRa packets from several nodes
+   and uses adaptive data rate (ADR) engine to find
+   the fastest data rate and lowest output power each node
+   can use, while keeping 10 dB margin above the lowest SNR
+   the data rate can still be received at.
+
+   Each packet is expected to start with 1-byte node address,
+   followed by output power the packet was transmitted with,
+   in dBm. The node can apply the recommended settings
+   using SX127x::buildProfile and SX127x::applyProfile.
+
+   ADR is included by LoRaLib.h, its header is
+   src/protocols/ADR/ADR.h
+
+   For more detailed information, see the LoRaLib Wiki
+   https://github.com/jgromes/LoRaLib/wiki
+
+   For full API reference, see the GitHub Pages
+   https://jgromes.github.io/LoRaLib/
+*/
+
+// include the library
+#include <LoRaLib.h>
+
+// create instance of LoRa class using SX1278 module
+// this pinout corresponds to RadioShield
+// https://github.com/jgromes/RadioShield
+// NSS pin:   10 (4 on ESP32/ESP8266 boards)
+// DIO0 pin:  2
+// DIO1 pin:  3
+SX1278 lora = new LoRa;
+
+// create instance of ADR engine with the built-in data
+// rate table (SF12 to SF7 at 125 kHz), output power
+// between 2 and 17 dBm and 10 dB margin
+ADR adr;
+
+void setup() {
+  Serial.begin(9600);
+
+  // initialize SX1278 with default settings
+  Serial.print(F("Initializing ... "));
+  // carrier frequency:           434.0 MHz
+  // bandwidth:                   125.0 kHz
+  // spreading factor:            9
+  // coding rate:                 7
+  // sync word:                   0x12
+  // output power:                17 dBm
+  // current limit:               100 mA
+  // preamble length:             8 symbols
+  // amplifier gain:              0 (automatic gain control)
+  int state = lora.begin();
+  if (state == ERR_NONE) {
+    Serial.println(F("success!"));
+  } else {
+    Serial.print(F("failed, code "));
+    Serial.println(state);
+    while (true);
+  }
+}
+
+void loop() {
+  Serial.print(F("Waiting for incoming transmission ... "));
+
+  // receive packet with node address and output power
+  uint8_t byteArr[8];
+  int state = lora.receive(byteArr, 8);
+
+  if (state == ERR_NONE) {
+    // packet was successfully received
+    Serial.println(F("success!"));
+
+    // record SNR of the packet, together with
+    // the output power the node used
+    uint8_t node = byteArr[0];
+    int8_t power = (int8_t)byteArr[1];
+    float snr = lora.getSNR();
+    adr.addSample(node, snr, power);
+
+    Serial.print(F("Node:\t\t\t"));
+    Serial.println(node);
+    Serial.print(F("SNR:\t\t\t"));
+    Serial.print(snr);
+    Serial.println(F(" dB"));
+
+    // recommendation is available after a few packets
+    // were received from the node
+    uint8_t dataRate;
+    int8_t recommendedPower;
+    if (adr.getRecommendation(node, &dataRate, &recommendedPower)) {
+      Serial.print(F("Recommended SF:\t\t"));
+      Serial.println(ADRDataRatesDefault[dataRate].sf);
+      Serial.print(F("Recommended power:\t"));
+      Serial.print(recommendedPower);
+      Serial.println(F(" dBm"));
+    } else {
+      Serial.println(F("Not enough samples yet"));
+    }
+
+  } else if (state == ERR_RX_TIMEOUT) {
+    // timeout occurred while waiting for a packet
+    Serial.println(F("timeout!"));
+
+  } else if (state == ERR_CRC_MISMATCH) {
+    // packet was received, but is malformed
+    Serial.println(F("CRC error!"));
+
+  }
+
+}
@@ -0,0 +1,116 @@
+/*
+   LoRaLib ARQ Example
+
+   This example transfers payload larger than a single
+   LoRa packet reliably. Payload is split into fragments,
+   receiver acknowledges them and only the missing
+   fragments are retransmitted.
+
+   Upload the example to two boards, with the variable
+   "sender" set to true on one of them and to false
+   on the other one. Both sides must use the same
+   LoRa settings and fragment size.
+
+   ARQClient is included by LoRaLib.h, its header is
+   src/protocols/ARQ/ARQ.h
+
+   For more detailed information, see the LoRaLib Wiki
+   https://github.com/jgromes/LoRaLib/wiki
+
+   For full API reference, see the GitHub Pages
+   https://jgromes.github.io/LoRaLib/
+*/
+
+// include the library
+#include <LoRaLib.h>
+
+// create instance of LoRa class using SX1278 module
+// this pinout corresponds to RadioShield
+// https://github.com/jgromes/RadioShield
+// NSS pin:   10 (4 on ESP32/ESP8266 boards)
+// DIO0 pin:  2
+// DIO1 pin:  3
+SX1278 lora = new LoRa;
+
+// create instance of ARQ client with the default
+// fragment size (48 bytes)
+ARQClient arq(&lora);
+
+// set to true on the transmitting board
+// and to false on the receiving board
+bool sender = true;
+
+// payload buffer, 4 fragments long
+uint8_t payload[192];
+
+void setup() {
+  Serial.begin(9600);
+
+  // initialize SX1278 with default settings
+  Serial.print(F("Initializing ... "));
+  // carrier frequency:           434.0 MHz
+  // bandwidth:                   125.0 kHz
+  // spreading factor:            9
+  // coding rate:                 7
+  // sync word:                   0x12
+  // output power:                17 dBm
+  // current limit:               100 mA
+  // preamble length:             8 symbols
+  // amplifier gain:              0 (automatic gain control)
+  int state = lora.begin();
+  if (state == ERR_NONE) {
+    Serial.println(F("success!"));
+  } else {
+    Serial.print(F("failed, code "));
+    Serial.println(state);
+    while (true);
+  }
+}
+
+void loop() {
+  if (sender) {
+    // fill the payload with some data
+    for (size_t i = 0; i < sizeof(payload); i++) {
+      payload[i] = (uint8_t)i;
+    }
+
+    // send the payload
+    // NOTE: send() is a blocking method, it returns
+    //       once all fragments were acknowledged
+    Serial.print(F("Sending payload ... "));
+    int state = arq.send(payload, sizeof(payload));
+    if (state == ERR_NONE) {
+      Serial.println(F("success!"));
+    } else if (state == ERR_ACK_NOT_RECEIVED) {
+      // receiver did not acknowledge the fragments
+      Serial.println(F("no acknowledgement!"));
+    } else {
+      Serial.print(F("failed, code "));
+      Serial.println(state);
+    }
+
+    // print total number of retransmitted fragments
+    Serial.print(F("Retransmissions:\t"));
+    Serial.println(arq.getRetransmissions());
+
+    // wait a second before sending again
+    delay(1000);
+
+  } else {
+    // receive the payload, waiting at most 10 seconds
+    // for the next fragment
+    Serial.print(F("Waiting for payload ... "));
+    size_t len = 0;
+    int state = arq.receive(payload, sizeof(payload), &len, 10000000UL);
+    if (state == ERR_NONE) {
+      Serial.println(F("success!"));
+      Serial.print(F("Length:\t\t\t"));
+      Serial.println(len);
+    } else if (state == ERR_RX_TIMEOUT) {
+      Serial.println(F("timeout!"));
+    } else {
+      Serial.print(F("failed, code "));
+      Serial.println(state);
+    }
+  }
+}
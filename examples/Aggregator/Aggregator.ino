@@ -0,0 +1,119 @@
+/*
+   LoRaLib Aggregator Example
+
+   This example packs short messages into a single LoRa
+   packet, so that preamble and header airtime is shared
+   by all of them. Packet is sent when the next message
+   does not fit, when the oldest message waited for too long,
+   or when the packet is long enough.
+
+   Upload the example to two boards, with the variable
+   "sender" set to true on one of them and to false
+   on the other one.
+
+   Aggregator is included by LoRaLib.h, its header is
+   src/protocols/Aggregator/Aggregator.h
+
+   For more detailed information, see the LoRaLib Wiki
+   https://github.com/jgromes/LoRaLib/wiki
+
+   For full API reference, see the GitHub Pages
+   https://jgromes.github.io/LoRaLib/
+*/
+
+// include the library
+#include <LoRaLib.h>
+
+// create instance of LoRa class using SX1278 module
+// this pinout corresponds to RadioShield
+// https://github.com/jgromes/RadioShield
+// NSS pin:   10 (4 on ESP32/ESP8266 boards)
+// DIO0 pin:  2
+// DIO1 pin:  3
+SX1278 lora = new LoRa;
+
+// create instance of aggregator
+Aggregator aggregator(&lora);
+
+// set to true on the transmitting board
+// and to false on the receiving board
+bool sender = true;
+
+// this function is called for each message
+// in the received packet
+void printMessage(uint8_t* data, size_t len) {
+  Serial.print(F("Message:\t\t"));
+  for (size_t i = 0; i < len; i++) {
+    Serial.print(data[i], HEX);
+    Serial.print(' ');
+  }
+  Serial.println();
+}
+
+void setup() {
+  Serial.begin(9600);
+
+  // initialize SX1278 with default settings
+  Serial.print(F("Initializing ... "));
+  // carrier frequency:           434.0 MHz
+  // bandwidth:                   125.0 kHz
+  // spreading factor:            9
+  // coding rate:                 7
+  // sync word:                   0x12
+  // output power:                17 dBm
+  // current limit:               100 mA
+  // preamble length:             8 symbols
+  // amplifier gain:              0 (automatic gain control)
+  int state = lora.begin();
+  if (state == ERR_NONE) {
+    Serial.println(F("success!"));
+  } else {
+    Serial.print(F("failed, code "));
+    Serial.println(state);
+    while (true);
+  }
+
+  // messages wait at most 5 seconds, and packet is sent
+  // once preamble and header take at most 20 % of airtime
+  aggregator.setFlushPolicy(5000000UL, 20);
+}
+
+// counter to keep track of queued messages
+uint8_t count = 0;
+
+void loop() {
+  if (sender) {
+    // queue a short message every second
+    uint8_t message[] = {0xAB, 0xCD, count++};
+    int state = aggregator.add(message, sizeof(message));
+    if (state != ERR_NONE) {
+      Serial.print(F("Failed to add message, code "));
+      Serial.println(state);
+    }
+
+    // send the queued messages if flush policy requires it
+    // NOTE: update() has to be called periodically
+    state = aggregator.update();
+    if (state != ERR_NONE) {
+      Serial.print(F("Transmission failed, code "));
+      Serial.println(state);
+    }
+
+    Serial.print(F("Queued messages:\t"));
+    Serial.println(aggregator.getQueued());
+    delay(1000);
+
+  } else {
+    // receive a packet and print each message in it
+    Serial.println(F("Waiting for incoming transmission ... "));
+    int state = aggregator.receive(printMessage);
+    if (state == ERR_NONE) {
+      Serial.println(F("Packet received!"));
+    } else if (state == ERR_RX_TIMEOUT) {
+      Serial.println(F("Timeout!"));
+    } else {
+      Serial.print(F("Reception failed, code "));
+      Serial.println(state);
+    }
+  }
+}
@@ -0,0 +1,133 @@
+/*
+   LoRaLib Checksum Example
+
+   This example protects payload with software CRC-32,
+   in addition to CRC-16 checked by the module. This is
+   useful when the module CRC is disabled, or when data
+   is verified end-to-end across several packets.
+
+   Upload the example to two boards, with the variable
+   "sender" set to true on one of them and to false
+   on the other one.
+
+   Checksum is included by LoRaLib.h, its header is
+   src/protocols/Checksum/Checksum.h
+
+   For more detailed information, see the LoRaLib Wiki
+   https://github.com/jgromes/LoRaLib/wiki
+
+   For full API reference, see the GitHub Pages
+   https://jgromes.github.io/LoRaLib/
+*/
+
+// include the library
+#include <LoRaLib.h>
+
+// create instance of LoRa class using SX1278 module
+// this pinout corresponds to RadioShield
+// https://github.com/jgromes/RadioShield
+// NSS pin:   10 (4 on ESP32/ESP8266 boards)
+// DIO0 pin:  2
+// DIO1 pin:  3
+SX1278 lora = new LoRa;
+
+// create instance of CRC-32 calculator
+// NOTE: lookup table is built in constructor,
+//       so the instance should be reused
+Checksum crc(ChecksumCRC32);
+
+// set to true on the transmitting board
+// and to false on the receiving board
+bool sender = true;
+
+// payload buffer, including 4 bytes of CRC
+uint8_t packet[16];
+
+void setup() {
+  Serial.begin(9600);
+
+  // initialize SX1278 with default settings
+  Serial.print(F("Initializing ... "));
+  // carrier frequency:           434.0 MHz
+  // bandwidth:                   125.0 kHz
+  // spreading factor:            9
+  // coding rate:                 7
+  // sync word:                   0x12
+  // output power:                17 dBm
+  // current limit:               100 mA
+  // preamble length:             8 symbols
+  // amplifier gain:              0 (automatic gain control)
+  int state = lora.begin();
+  if (state == ERR_NONE) {
+    Serial.println(F("success!"));
+  } else {
+    Serial.print(F("failed, code "));
+    Serial.println(state);
+    while (true);
+  }
+}
+
+// counter to keep track of transmitted packets
+uint8_t count = 0;
+
+void loop() {
+  size_t payloadLen = sizeof(packet) - 4;
+
+  if (sender) {
+    // fill the payload with some data
+    for (size_t i = 0; i < payloadLen; i++) {
+      packet[i] = count + i;
+    }
+    count++;
+
+    // append CRC-32 of the payload
+    uint32_t value = crc.calculate(packet, payloadLen);
+    for (uint8_t i = 0; i < 4; i++) {
+      packet[payloadLen + i] = (uint8_t)(value >> (8 * i));
+    }
+
+    Serial.print(F("Sending packet ... "));
+    int state = lora.transmit(packet, sizeof(packet));
+    if (state == ERR_NONE) {
+      Serial.println(F("success!"));
+    } else {
+      Serial.print(F("failed, code "));
+      Serial.println(state);
+    }
+
+    Serial.print(F("CRC-32:\t\t\t0x"));
+    Serial.println(value, HEX);
+    delay(1000);
+
+  } else {
+    Serial.print(F("Waiting for incoming transmission ... "));
+    int state = lora.receive(packet, sizeof(packet));
+    if (state == ERR_NONE) {
+      Serial.println(F("success!"));
+
+      // calculate CRC-32 of the payload and compare it
+      // with the received one
+      uint32_t value = crc.calculate(packet, payloadLen);
+      uint32_t received = 0;
+      for (uint8_t i = 0; i < 4; i++) {
+        received |= (uint32_t)packet[payloadLen + i] << (8 * i);
+      }
+
+      Serial.print(F("CRC-32:\t\t\t0x"));
+      Serial.print(value, HEX);
+      if (value == received) {
+        Serial.println(F(" (OK)"));
+      } else {
+        Serial.println(F(" (mismatch)"));
+      }
+
+    } else if (state == ERR_RX_TIMEOUT) {
+      Serial.println(F("timeout!"));
+    } else if (state == ERR_CRC_MISMATCH) {
+      Serial.println(F("CRC error!"));
+    } else {
+      Serial.print(F("failed, code "));
+      Serial.println(state);
+    }
+  }
+}
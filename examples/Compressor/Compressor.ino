@@ -0,0 +1,120 @@
+/*
+   LoRaLib Compressor Example
+
+   This example compresses payload before transmission
+   and decompresses it after reception, which shortens
+   time-on-air of repetitive data. In delta mode, previous
+   frame is used as dictionary, so that sensor readings
+   that change only a little are sent in a few bytes.
+
+   Upload the example to two boards, with the variable
+   "sender" set to true on one of them and to false
+   on the other one.
+
+   Compressor is included by LoRaLib.h, its header is
+   src/protocols/Compressor/Compressor.h
+
+   For more detailed information, see the LoRaLib Wiki
+   https://github.com/jgromes/LoRaLib/wiki
+
+   For full API reference, see the GitHub Pages
+   https://jgromes.github.io/LoRaLib/
+*/
+
+// include the library
+#include <LoRaLib.h>
+
+// create instance of LoRa class using SX1278 module
+// this pinout corresponds to RadioShield
+// https://github.com/jgromes/RadioShield
+// NSS pin:   10 (4 on ESP32/ESP8266 boards)
+// DIO0 pin:  2
+// DIO1 pin:  3
+SX1278 lora = new LoRa;
+
+// create instance of compressor
+Compressor compressor(&lora);
+
+// set to true on the transmitting board
+// and to false on the receiving board
+bool sender = true;
+
+// payload buffer
+uint8_t payload[64];
+
+void setup() {
+  Serial.begin(9600);
+
+  // initialize SX1278 with default settings
+  Serial.print(F("Initializing ... "));
+  // carrier frequency:           434.0 MHz
+  // bandwidth:                   125.0 kHz
+  // spreading factor:            9
+  // coding rate:                 7
+  // sync word:                   0x12
+  // output power:                17 dBm
+  // current limit:               100 mA
+  // preamble length:             8 symbols
+  // amplifier gain:              0 (automatic gain control)
+  int state = lora.begin();
+  if (state == ERR_NONE) {
+    Serial.println(F("success!"));
+  } else {
+    Serial.print(F("failed, code "));
+    Serial.println(state);
+    while (true);
+  }
+
+  // use previous frame as dictionary, and send a frame
+  // without dictionary after every 8 delta frames,
+  // so that the receiver can recover after a lost frame
+  compressor.setDeltaMode(true);
+  compressor.setKeyframeInterval(8);
+
+  // fill the payload with some repetitive data
+  for (size_t i = 0; i < sizeof(payload); i++) {
+    payload[i] = i % 8;
+  }
+}
+
+// counter to keep track of transmitted packets
+uint8_t count = 0;
+
+void loop() {
+  if (sender) {
+    // change a single byte, as a sensor reading would
+    payload[0] = count++;
+
+    // compress and transmit the payload
+    Serial.print(F("Sending compressed payload ... "));
+    int state = compressor.transmit(payload, sizeof(payload));
+    if (state == ERR_NONE) {
+      Serial.println(F("success!"));
+    } else {
+      Serial.print(F("failed, code "));
+      Serial.println(state);
+    }
+
+    delay(1000);
+
+  } else {
+    // receive and decompress the payload
+    Serial.print(F("Waiting for incoming transmission ... "));
+    size_t len = 0;
+    int state = compressor.receive(payload, sizeof(payload), &len);
+    if (state == ERR_NONE) {
+      Serial.println(F("success!"));
+      Serial.print(F("Length:\t\t\t"));
+      Serial.println(len);
+
+      // print length of the compressed packet
+      Serial.print(F("Compressed length:\t"));
+      Serial.println(lora.getPacketLength());
+    } else if (state == ERR_RX_TIMEOUT) {
+      Serial.println(F("timeout!"));
+    } else {
+      Serial.print(F("failed, code "));
+      Serial.println(state);
+    }
+  }
+}
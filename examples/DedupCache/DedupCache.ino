@@ -0,0 +1,127 @@
+/*
+   LoRaLib Duplicate Cache Example
+
+   This example uses two SX1278 modules with separate
+   antennas listening on the same channel. Most packets
+   are received by both modules, duplicate cache makes sure
+   each packet is processed only once, and keeps track
+   of the copy received with the best quality.
+
+   DedupCache is included by LoRaLib.h, its header is
+   src/protocols/DedupCache/DedupCache.h
+
+   For more detailed information, see the LoRaLib Wiki
+   https://github.com/jgromes/LoRaLib/wiki
+
+   For full API reference, see the GitHub Pages
+   https://jgromes.github.io/LoRaLib/
+*/
+
+// include the library
+#include <LoRaLib.h>
+
+// create instance of LoRa class using SX1278 module
+// this pinout corresponds to RadioShield
+// https://github.com/jgromes/RadioShield
+// NSS pin:   10 (4 on ESP32/ESP8266 boards)
+// DIO0 pin:  2
+// DIO1 pin:  3
+SX1278 lora1 = new LoRa;
+
+// create another instance of LoRa class using
+// SX1278 module and user-specified pinout
+// NSS pin:   6
+// DIO0 pin:  4
+// DIO1 pin:  5
+SX1278 lora2 = new LoRa(6, 4, 5);
+
+// create instance of the gateway, which reads packets
+// from both modules into a single queue
+Gateway gateway;
+
+// create instance of duplicate cache, copies received
+// within 1 second of the first one are duplicates
+DedupCache cache(1000000UL);
+
+void setup() {
+  Serial.begin(9600);
+
+  // initialize both SX1278 modules with default settings
+  Serial.print(F("Initializing ... "));
+  int state = lora1.begin();
+  if (state == ERR_NONE) {
+    state = lora2.begin();
+  }
+  if (state == ERR_NONE) {
+    Serial.println(F("success!"));
+  } else {
+    Serial.print(F("failed, code "));
+    Serial.println(state);
+    while (true);
+  }
+
+  // add both modules to the gateway,
+  // with the same channel and settings
+  Serial.print(F("Starting gateway ... "));
+  SX127xProfile profile;
+  state = lora1.buildProfile(9, 125.0, 7, 17, profile);
+  if (state == ERR_NONE) {
+    state = gateway.addRadio(&lora1, 434.0, profile);
+  }
+  if (state == ERR_NONE) {
+    state = gateway.addRadio(&lora2, 434.0, profile);
+  }
+  if (state == ERR_NONE) {
+    state = gateway.begin();
+  }
+  if (state == ERR_NONE) {
+    Serial.println(F("success!"));
+  } else {
+    Serial.print(F("failed, code "));
+    Serial.println(state);
+    while (true);
+  }
+}
+
+void loop() {
+  // read received packets into the queue
+  gateway.service();
+
+  GatewayPacket packet;
+  while (gateway.read(&packet)) {
+    // check the packet against the cache
+    uint8_t result = cache.check(packet.data, packet.len, packet.rssi, packet.snr, packet.radio);
+
+    if (result == DEDUP_NEW) {
+      // first copy, process the packet
+      Serial.print(F("New packet from radio "));
+      Serial.print(packet.radio);
+      Serial.print(F(", SNR "));
+      Serial.print(packet.snr);
+      Serial.println(F(" dB"));
+
+    } else if (result == DEDUP_BETTER) {
+      // duplicate with better quality than the first copy
+      Serial.print(F("Better copy from radio "));
+      Serial.print(packet.radio);
+      Serial.print(F(", SNR "));
+      Serial.print(packet.snr);
+      Serial.println(F(" dB"));
+
+    } else {
+      // duplicate, ignore it
+      Serial.print(F("Duplicate from radio "));
+      Serial.println(packet.radio);
+
+    }
+
+    // get the best copy received so far
+    DedupEntry best;
+    if (cache.getBest(packet.data, packet.len, &best)) {
+      Serial.print(F("Copies:\t\t\t"));
+      Serial.println(best.count);
+      Serial.print(F("Best radio:\t\t"));
+      Serial.println(best.radio);
+    }
+  }
+}
@@ -0,0 +1,128 @@
+/*
+   LoRaLib Direct Capture Example
+
+   This example captures raw bitstream from SX1278 FSK modem
+   in direct mode, and searches it for frames that start
+   with a sync word. This allows to receive frames that
+   do not fit packet mode of the module, e.g. with
+   sync word errors or non-standard framing.
+
+   Data clock (DIO1) and data (DIO2) are read through
+   Linux GPIO character device, so this example only
+   works on Linux.
+
+   DirectCapture and SyncWordCorrelator are included
+   by LoRaLib.h, their headers are in
+   src/protocols/DirectCapture/
+
+   For more detailed information, see the LoRaLib Wiki
+   https://github.com/jgromes/LoRaLib/wiki
+
+   For full API reference, see the GitHub Pages
+   https://jgromes.github.io/LoRaLib/
+*/
+
+// include the library
+#include <LoRaLib.h>
+
+// create instance of LoRa class using SX1278 module
+// this pinout corresponds to RadioShield
+// https://github.com/jgromes/RadioShield
+// NSS pin:   10 (4 on ESP32/ESP8266 boards)
+// DIO0 pin:  2
+// DIO1 pin:  3
+SX1278 fsk = new LoRa;
+
+#if defined(LINUX)
+// GPIO chip and offsets of lines connected to DIO1 and DIO2
+const char* gpioChip = "/dev/gpiochip0";
+uint32_t clkLine = 3;
+uint32_t dataLine = 4;
+
+// create instance of direct mode capture
+DirectCapture capture(&fsk);
+
+// create instance of frame correlator
+SyncWordCorrelator correlator;
+
+// number of lost bytes reported so far
+uint32_t dropped = 0;
+#endif
+
+void setup() {
+  Serial.begin(9600);
+
+#if defined(LINUX)
+  // initialize SX1278 FSK modem with default settings
+  Serial.print(F("Initializing ... "));
+  // carrier frequency:           434.0 MHz
+  // bit rate:                    48.0 kbps
+  // frequency deviation:         50.0 kHz
+  // Rx bandwidth:                125.0 kHz
+  // output power:                13 dBm
+  // current limit:               100 mA
+  // data shaping:                Gaussian, BT = 0.3
+  // sync word:                   0x2D  0x01
+  // OOK modulation:              false
+  int state = fsk.beginFSK();
+  if (state == ERR_NONE) {
+    Serial.println(F("success!"));
+  } else {
+    Serial.print(F("failed, code "));
+    Serial.println(state);
+    while (true);
+  }
+
+  // search for 16-bit sync word 0x2D01 with at most
+  // 1 bit error, followed by 8-byte frame
+  state = correlator.begin(0x2D01, 16, 1, 8);
+  if (state != ERR_NONE) {
+    Serial.print(F("Failed to configure correlator, code "));
+    Serial.println(state);
+    while (true);
+  }
+
+  // switch to direct mode and start capture thread
+  Serial.print(F("Starting capture ... "));
+  state = capture.begin(gpioChip, clkLine, dataLine);
+  if (state == ERR_NONE) {
+    Serial.println(F("success!"));
+  } else {
+    Serial.print(F("failed, code "));
+    Serial.println(state);
+    while (true);
+  }
+#else
+  // GPIO character device is only available on Linux
+  Serial.println(F("Direct capture is only supported on Linux!"));
+  while (true);
+#endif
+}
+
+void loop() {
+#if defined(LINUX)
+  // feed captured bits into the correlator
+  uint8_t frame[8];
+  uint64_t timestamp = 0;
+  size_t len = capture.readFrame(correlator, frame, sizeof(frame), &timestamp);
+  if (len > 0) {
+    Serial.print(F("Frame at "));
+    Serial.print(timestamp);
+    Serial.print(F(" ns:\t"));
+    for (size_t i = 0; i < len; i++) {
+      Serial.print(frame[i], HEX);
+      Serial.print(' ');
+    }
+    Serial.println();
+  }
+
+  // print number of lost bytes
+  if (capture.getDropped() != dropped) {
+    dropped = capture.getDropped();
+    Serial.print(F("Dropped bytes:\t\t"));
+    Serial.println(dropped);
+  }
+
+  delay(10);
+#endif
+}
@@ -0,0 +1,126 @@
+/*
+   LoRaLib FEC Example
+
+   This example uses forward error correction (erasure coding)
+   across packets. Payloads are sent immediately, and after
+   every block of 4 payloads, 2 repair packets are sent.
+   Receiver can rebuild up to 2 lost payloads of each block
+   from the repair packets, without asking for retransmission.
+
+   Upload the example to two boards, with the variable
+   "sender" set to true on one of them and to false
+   on the other one.
+
+   FECEncoder and FECDecoder are included by LoRaLib.h,
+   their header is src/protocols/FEC/FEC.h
+
+   For more detailed information, see the LoRaLib Wiki
+   https://github.com/jgromes/LoRaLib/wiki
+
+   For full API reference, see the GitHub Pages
+   https://jgromes.github.io/LoRaLib/
+*/
+
+// include the library
+#include <LoRaLib.h>
+
+// create instance of LoRa class using SX1278 module
+// this pinout corresponds to RadioShield
+// https://github.com/jgromes/RadioShield
+// NSS pin:   10 (4 on ESP32/ESP8266 boards)
+// DIO0 pin:  2
+// DIO1 pin:  3
+SX1278 lora = new LoRa;
+
+// create instances of FEC encoder and decoder
+FECEncoder encoder(&lora);
+FECDecoder decoder(&lora);
+
+// set to true on the transmitting board
+// and to false on the receiving board
+bool sender = true;
+
+// this function is called for each payload, either
+// received directly or rebuilt from repair packets
+void printPayload(uint8_t* data, size_t len) {
+  Serial.print(F("Payload:\t\t"));
+  for (size_t i = 0; i < len; i++) {
+    Serial.print(data[i], HEX);
+    Serial.print(' ');
+  }
+  Serial.println();
+}
+
+void setup() {
+  Serial.begin(9600);
+
+  // initialize SX1278 with default settings
+  Serial.print(F("Initializing ... "));
+  // carrier frequency:           434.0 MHz
+  // bandwidth:                   125.0 kHz
+  // spreading factor:            9
+  // coding rate:                 7
+  // sync word:                   0x12
+  // output power:                17 dBm
+  // current limit:               100 mA
+  // preamble length:             8 symbols
+  // amplifier gain:              0 (automatic gain control)
+  int state = lora.begin();
+  if (state == ERR_NONE) {
+    Serial.println(F("success!"));
+  } else {
+    Serial.print(F("failed, code "));
+    Serial.println(state);
+    while (true);
+  }
+
+  // send 2 repair packets after every 4 payloads
+  state = encoder.setBlockSize(4, 2);
+  if (state != ERR_NONE) {
+    Serial.print(F("Failed to set block size, code "));
+    Serial.println(state);
+    while (true);
+  }
+}
+
+// counter to keep track of transmitted payloads
+uint8_t count = 0;
+
+void loop() {
+  if (sender) {
+    // transmit the payload
+    // NOTE: after every 4th payload, transmit() also sends
+    //       the repair packets of the block
+    Serial.print(F("Sending payload ... "));
+    uint8_t payload[] = {0x01, 0x23, 0x45, 0x67, count++};
+    int state = encoder.transmit(payload, sizeof(payload));
+    if (state == ERR_NONE) {
+      Serial.println(F("success!"));
+    } else {
+      Serial.print(F("failed, code "));
+      Serial.println(state);
+    }
+
+    delay(1000);
+
+  } else {
+    // receive a packet and print all payloads
+    // that became available
+    Serial.println(F("Waiting for incoming transmission ... "));
+    int state = decoder.receive(printPayload);
+    if (state == ERR_NONE) {
+      Serial.println(F("Packet received!"));
+    } else if (state == ERR_RX_TIMEOUT) {
+      Serial.println(F("Timeout!"));
+    } else {
+      Serial.print(F("Reception failed, code "));
+      Serial.println(state);
+    }
+
+    // print number of rebuilt and lost payloads
+    Serial.print(F("Recovered:\t\t"));
+    Serial.println(decoder.getRecovered());
+    Serial.print(F("Lost:\t\t\t"));
+    Serial.println(decoder.getLost());
+  }
+}
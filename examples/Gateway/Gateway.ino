@@ -0,0 +1,156 @@
+/*
+   LoRaLib Gateway Example
+
+   This example shows how to use two SX1278 modules as
+   a simple multi-channel gateway. Each module listens
+   continuously on its own channel with its own settings,
+   packets received by both modules are read from a single
+   queue, ordered by the time of reception.
+
+   Gateway is included by LoRaLib.h, its header is
+   src/protocols/Gateway/Gateway.h
+
+   For more detailed information, see the LoRaLib Wiki
+   https://github.com/jgromes/LoRaLib/wiki
+
+   For full API reference, see the GitHub Pages
+   https://jgromes.github.io/LoRaLib/
+*/
+
+// include the library
+#include <LoRaLib.h>
+
+// create instance of LoRa class using SX1278 module
+// this pinout corresponds to RadioShield
+// https://github.com/jgromes/RadioShield
+// NSS pin:   10 (4 on ESP32/ESP8266 boards)
+// DIO0 pin:  2
+// DIO1 pin:  3
+SX1278 lora1 = new LoRa;
+
+// create another instance of LoRa class using
+// SX1278 module and user-specified pinout
+// NSS pin:   6
+// DIO0 pin:  4
+// DIO1 pin:  5
+SX1278 lora2 = new LoRa(6, 4, 5);
+
+// create instance of the gateway
+Gateway gateway;
+
+void setup() {
+  Serial.begin(9600);
+
+  // initialize both SX1278 modules with default settings
+  Serial.print(F("Initializing ... "));
+  int state = lora1.begin();
+  if (state == ERR_NONE) {
+    state = lora2.begin();
+  }
+  if (state == ERR_NONE) {
+    Serial.println(F("success!"));
+  } else {
+    Serial.print(F("failed, code "));
+    Serial.println(state);
+    while (true);
+  }
+
+  // add both modules to the gateway, each with its own
+  // channel and modem settings
+  // profile is built once, and applied by the gateway
+  // using raw register writes only
+  Serial.print(F("Adding radios ... "));
+  SX127xProfile profile1;
+  SX127xProfile profile2;
+  state = lora1.buildProfile(9, 125.0, 7, 17, profile1);
+  if (state == ERR_NONE) {
+    state = lora2.buildProfile(7, 250.0, 5, 17, profile2);
+  }
+  if (state == ERR_NONE) {
+    state = gateway.addRadio(&lora1, 434.0, profile1);
+  }
+  if (state == ERR_NONE) {
+    state = gateway.addRadio(&lora2, 434.5, profile2);
+  }
+  if (state == ERR_NONE) {
+    Serial.println(F("success!"));
+  } else {
+    Serial.print(F("failed, code "));
+    Serial.println(state);
+    while (true);
+  }
+
+  // configure the modules and start listening
+  // NOTE: gateway.service() polls DIO0 pins, so it has
+  //       to be called from loop()
+  Serial.print(F("Starting gateway ... "));
+  state = gateway.begin();
+  if (state == ERR_NONE) {
+    Serial.println(F("success!"));
+  } else {
+    Serial.print(F("failed, code "));
+    Serial.println(state);
+    while (true);
+  }
+}
+
+// counter to keep track of transmitted packets
+int count = 0;
+
+// time of the last transmission
+unsigned long lastTransmit = 0;
+
+void loop() {
+  // read received packets into the queue
+  // and finish transmissions
+  gateway.service();
+
+  // read all packets waiting in the queue
+  GatewayPacket packet;
+  while (gateway.read(&packet)) {
+    Serial.print(F("Received packet on radio "));
+    Serial.print(packet.radio);
+    Serial.print(F(" at "));
+    Serial.print(packet.freq);
+    Serial.println(F(" MHz"));
+
+    Serial.print(F("Length:\t\t\t"));
+    Serial.println(packet.len);
+
+    Serial.print(F("RSSI:\t\t\t"));
+    Serial.print(packet.rssi);
+    Serial.println(F(" dBm"));
+
+    Serial.print(F("SNR:\t\t\t"));
+    Serial.print(packet.snr);
+    Serial.println(F(" dB"));
+
+    Serial.print(F("Timestamp:\t\t"));
+    Serial.print(packet.timestamp);
+    Serial.println(F(" us"));
+  }
+
+  // transmit a packet every 10 seconds
+  // the gateway uses an idle radio listening on 434.0 MHz,
+  // which returns to reception when transmission is done
+  if (millis() - lastTransmit > 10000) {
+    lastTransmit = millis();
+
+    uint8_t data[] = {0x01, 0x23, 0x45, 0x67, (uint8_t)count};
+    int state = gateway.transmit(data, sizeof(data), 434.0);
+    if (state == ERR_NONE) {
+      Serial.print(F("Transmitted packet #"));
+      Serial.println(count++);
+    } else {
+      Serial.print(F("Transmission failed, code "));
+      Serial.println(state);
+    }
+
+    // print number of packets that did not fit into the queue,
+    // and of packets that failed CRC check
+    Serial.print(F("Dropped packets:\t"));
+    Serial.println(gateway.getDropped());
+    Serial.print(F("Failed packets:\t\t"));
+    Serial.println(gateway.getErrors());
+  }
+}
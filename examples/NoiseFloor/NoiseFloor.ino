@@ -0,0 +1,97 @@
+/*
+   LoRaLib Noise Floor Example
+
+   This example estimates noise floor of the channel
+   from instantaneous RSSI samples, and derives adaptive
+   threshold above which the channel is considered busy,
+   e.g. for listen-before-talk.
+
+   NoiseFloor is included by LoRaLib.h, its header is
+   src/protocols/NoiseFloor/NoiseFloor.h
+
+   For more detailed information, see the LoRaLib Wiki
+   https://github.com/jgromes/LoRaLib/wiki
+
+   For full API reference, see the GitHub Pages
+   https://jgromes.github.io/LoRaLib/
+*/
+
+// include the library
+#include <LoRaLib.h>
+
+// create instance of LoRa class using SX1278 module
+// this pinout corresponds to RadioShield
+// https://github.com/jgromes/RadioShield
+// NSS pin:   10 (4 on ESP32/ESP8266 boards)
+// DIO0 pin:  2
+// DIO1 pin:  3
+SX1278 lora = new LoRa;
+
+// create instance of noise floor estimator
+// channel is busy when RSSI is 6 dB above
+// the 25th percentile of samples
+NoiseFloor noise(0.05, 6.0, 25);
+
+void setup() {
+  Serial.begin(9600);
+
+  // initialize SX1278 with default settings
+  Serial.print(F("Initializing ... "));
+  // carrier frequency:           434.0 MHz
+  // bandwidth:                   125.0 kHz
+  // spreading factor:            9
+  // coding rate:                 7
+  // sync word:                   0x12
+  // output power:                17 dBm
+  // current limit:               100 mA
+  // preamble length:             8 symbols
+  // amplifier gain:              0 (automatic gain control)
+  int state = lora.begin();
+  if (state == ERR_NONE) {
+    Serial.println(F("success!"));
+  } else {
+    Serial.print(F("failed, code "));
+    Serial.println(state);
+    while (true);
+  }
+
+  // RSSI can only be measured in receive mode
+  Serial.print(F("Starting to listen ... "));
+  state = lora.startReceive();
+  if (state == ERR_NONE) {
+    Serial.println(F("success!"));
+  } else {
+    Serial.print(F("failed, code "));
+    Serial.println(state);
+    while (true);
+  }
+}
+
+void loop() {
+  // collect RSSI samples for one second
+  for (int i = 0; i < 100; i++) {
+    // getCurrentRSSI() reads a single register,
+    // and does not change operation mode
+    noise.addSample(lora.getCurrentRSSI());
+    delay(10);
+  }
+
+  // print the estimate
+  Serial.print(F("Noise floor:\t\t"));
+  Serial.print(noise.getNoiseFloor());
+  Serial.println(F(" dBm"));
+
+  Serial.print(F("Busy threshold:\t\t"));
+  Serial.print(noise.getThreshold());
+  Serial.println(F(" dBm"));
+
+  Serial.print(F("Samples:\t\t"));
+  Serial.println(noise.getNumSamples());
+
+  // check whether the channel is busy right now
+  if (noise.isBusy(lora.getCurrentRSSI())) {
+    Serial.println(F("Channel is busy"));
+  } else {
+    Serial.println(F("Channel is free"));
+  }
+}
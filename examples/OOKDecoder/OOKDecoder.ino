@@ -0,0 +1,106 @@
+/*
+   LoRaLib OOK Decoder Example
+
+   This example receives OOK transmissions from cheap
+   433 MHz sensors and remote controls. The module is
+   switched to direct mode, where demodulated data is
+   output on DIO2. Edges on DIO2 are timestamped and
+   decoded using built-in table of pulse timings.
+
+   DIO2 must be connected to a pin that supports
+   pin change interrupts.
+
+   OOKDecoder is included by LoRaLib.h, its header is
+   src/protocols/OOKDecoder/OOKDecoder.h
+
+   For more detailed information, see the LoRaLib Wiki
+   https://github.com/jgromes/LoRaLib/wiki
+
+   For full API reference, see the GitHub Pages
+   https://jgromes.github.io/LoRaLib/
+*/
+
+// include the library
+#include <LoRaLib.h>
+
+// create instance of LoRa class using SX1278 module
+// this pinout corresponds to RadioShield
+// https://github.com/jgromes/RadioShield
+// NSS pin:   10 (4 on ESP32/ESP8266 boards)
+// DIO0 pin:  2
+// DIO1 pin:  3
+SX1278 fsk = new LoRa;
+
+// DIO2 pin, DIO1 is not used in direct mode,
+// so the same interrupt-capable pin can be used
+int dio2Pin = 3;
+
+// create instance of OOK decoder
+OOKDecoder decoder(&fsk);
+
+void setup() {
+  Serial.begin(9600);
+
+  // initialize SX1278 FSK modem with OOK modulation
+  Serial.print(F("Initializing ... "));
+  // carrier frequency:           433.92 MHz
+  // bit rate:                    4.8 kbps
+  // frequency deviation:         5.0 kHz
+  // Rx bandwidth:                250.0 kHz
+  // output power:                13 dBm
+  // current limit:               100 mA
+  // preamble length:             16 bits
+  // OOK modulation:              true
+  int state = fsk.beginFSK(433.92, 4.8, 5.0, 250.0, 13, 100, 16, true);
+  if (state == ERR_NONE) {
+    Serial.println(F("success!"));
+  } else {
+    Serial.print(F("failed, code "));
+    Serial.println(state);
+    while (true);
+  }
+
+  // switch to direct mode and start decoding
+  Serial.print(F("Starting decoder ... "));
+  state = decoder.begin(dio2Pin);
+  if (state == ERR_NONE) {
+    Serial.println(F("success!"));
+  } else {
+    Serial.print(F("failed, code "));
+    Serial.println(state);
+    while (true);
+  }
+}
+
+// number of dropped edges reported so far
+uint32_t dropped = 0;
+
+void loop() {
+  // process timestamped edges
+  // NOTE: decode() has to be called at least once per frame
+  OOKFrame frame;
+  while (decoder.decode(frame)) {
+    Serial.print(F("Protocol:\t\t"));
+    Serial.println(frame.protocol->name);
+
+    Serial.print(F("Bits:\t\t\t"));
+    Serial.println(frame.numBits);
+
+    Serial.print(F("Data:\t\t\t"));
+    for (uint16_t i = 0; i < (frame.numBits + 7) / 8; i++) {
+      Serial.print(frame.data[i], HEX);
+      Serial.print(' ');
+    }
+    Serial.println();
+  }
+
+  // print number of edges lost because decode()
+  // was not called often enough
+  if (decoder.getDropped() != dropped) {
+    dropped = decoder.getDropped();
+    Serial.print(F("Dropped edges:\t\t"));
+    Serial.println(dropped);
+  }
+
+  delay(10);
+}
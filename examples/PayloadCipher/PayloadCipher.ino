@@ -0,0 +1,122 @@
+/*
+   LoRaLib Payload Cipher Example
+
+   This example encrypts and authenticates LoRa payload
+   using AES-128. Payload is encrypted while it is written
+   to the module and decrypted while it is read, packets
+   that were modified, sent with a different key, or replayed
+   are rejected.
+
+   Upload the example to two boards, with the variable
+   "sender" set to true on one of them and to false
+   on the other one. Both sides must use the same keys
+   and nonce.
+
+   AESCipher is included by LoRaLib.h, its header is
+   src/protocols/PayloadCipher/AESCipher.h
+
+   For more detailed information, see the LoRaLib Wiki
+   https://github.com/jgromes/LoRaLib/wiki
+
+   For full API reference, see the GitHub Pages
+   https://jgromes.github.io/LoRaLib/
+*/
+
+// include the library
+#include <LoRaLib.h>
+
+// create instance of LoRa class using SX1278 module
+// this pinout corresponds to RadioShield
+// https://github.com/jgromes/RadioShield
+// NSS pin:   10 (4 on ESP32/ESP8266 boards)
+// DIO0 pin:  2
+// DIO1 pin:  3
+SX1278 lora = new LoRa;
+
+// create instance of AES cipher
+AESCipher cipher;
+
+// encryption and authentication keys
+// NOTE: use your own random keys!
+const uint8_t encKey[16] = {0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6,
+                            0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C};
+const uint8_t macKey[16] = {0x60, 0x3D, 0xEB, 0x10, 0x15, 0xCA, 0x71, 0xBE,
+                            0x2B, 0x73, 0xAE, 0xF0, 0x85, 0x7D, 0x77, 0x81};
+
+// link nonce, e.g. address of the transmitter
+const uint8_t nonce[AES_CIPHER_NONCE_LENGTH] = {0x00, 0x00, 0x00, 0x00, 0x12, 0x34, 0x56, 0x78};
+
+// set to true on the transmitting board
+// and to false on the receiving board
+bool sender = true;
+
+void setup() {
+  Serial.begin(9600);
+
+  // initialize SX1278 with default settings
+  Serial.print(F("Initializing ... "));
+  // carrier frequency:           434.0 MHz
+  // bandwidth:                   125.0 kHz
+  // spreading factor:            9
+  // coding rate:                 7
+  // sync word:                   0x12
+  // output power:                17 dBm
+  // current limit:               100 mA
+  // preamble length:             8 symbols
+  // amplifier gain:              0 (automatic gain control)
+  int state = lora.begin();
+  if (state == ERR_NONE) {
+    Serial.println(F("success!"));
+  } else {
+    Serial.print(F("failed, code "));
+    Serial.println(state);
+    while (true);
+  }
+
+  // set keys and nonce, and attach the cipher to the module
+  // NOTE: frame counter must never repeat for the same keys,
+  //       save the value returned by cipher.getFrameCounter()
+  //       and restore it by cipher.setFrameCounter() after reset
+  cipher.setKeys(encKey, macKey);
+  cipher.setNonce(nonce);
+  lora.setPayloadCipher(&cipher);
+}
+
+void loop() {
+  if (sender) {
+    // transmit the payload, cipher header and tag
+    // are added automatically
+    Serial.print(F("Sending encrypted packet ... "));
+    int state = lora.transmit("Hello World!");
+    if (state == ERR_NONE) {
+      Serial.println(F("success!"));
+    } else {
+      Serial.print(F("failed, code "));
+      Serial.println(state);
+    }
+
+    Serial.print(F("Next frame counter:\t"));
+    Serial.println(cipher.getFrameCounter());
+    delay(1000);
+
+  } else {
+    // receive and decrypt the payload
+    Serial.print(F("Waiting for incoming transmission ... "));
+    String str;
+    int state = lora.receive(str);
+    if (state == ERR_NONE) {
+      Serial.println(F("success!"));
+      Serial.print(F("Data:\t\t\t"));
+      Serial.println(str);
+    } else if (state == ERR_MIC_MISMATCH) {
+      // packet was modified, sent with a different key,
+      // or its frame counter was already used
+      Serial.println(F("authentication failed!"));
+    } else if (state == ERR_RX_TIMEOUT) {
+      Serial.println(F("timeout!"));
+    } else {
+      Serial.print(F("failed, code "));
+      Serial.println(state);
+    }
+  }
+}
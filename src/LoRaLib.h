@@ -10,12 +10,21 @@
   Documentation for most common methods can be found in SX127x reference.\n
   Some methods (mainly configuration) are also overridden in derived classes, such as SX1272, SX1278, RFM96 etc.\n
   \ref status_codes have their own page.\n
+  Optional protocol layers that run on top of SX127x (ADR, ARQClient, Aggregator, Compressor, FECEncoder/FECDecoder, AESCipher, Checksum,
+  DedupCache, Gateway, NoiseFloor, OOKDecoder and DirectCapture) are included by LoRaLib.h as well, their headers are in src/protocols.\n
 
   \see https://github.com/jgromes/LoRaLib
 
   \copyright  Copyright (c) 2019 Jan Gromes
 */
 
+#ifdef LINUX
+  // standard headers used by DirectCapture and Gateway must be included before Arduino compatibility macros in TypeDef.h
+  #include <atomic>
+  #include <thread>
+  #include <mutex>
+#endif
+
 #include "TypeDef.h"
 #include "Module.h"
 
@@ -34,6 +43,19 @@
 #include "modules/RFM9x/RFM96.h"
 #include "modules/RFM9x/RFM97.h"
 
+#include "protocols/ADR/ADR.h"
+#include "protocols/ARQ/ARQ.h"
+#include "protocols/Aggregator/Aggregator.h"
+#include "protocols/Checksum/Checksum.h"
+#include "protocols/Compressor/Compressor.h"
+#include "protocols/DedupCache/DedupCache.h"
+#include "protocols/DirectCapture/DirectCapture.h"
+#include "protocols/FEC/FEC.h"
+#include "protocols/Gateway/Gateway.h"
+#include "protocols/NoiseFloor/NoiseFloor.h"
+#include "protocols/OOKDecoder/OOKDecoder.h"
+#include "protocols/PayloadCipher/AESCipher.h"
+
 /*!
   \class LoRa
 
@@ -1,10 +1,26 @@
 #include "Module.h"
 
+#ifdef LINUX
+  #include <time.h>
+  #include <errno.h>
+#endif
+
 Module::Module(RADIOLIB_PIN_TYPE cs, RADIOLIB_PIN_TYPE int0, RADIOLIB_PIN_TYPE int1, RADIOLIB_PIN_TYPE rst, SPIClass& spi) {
   // save pins numbers to private global variables
   _cs = cs;
   _int0 = int0;
   _int1 = int1;
+  _int2 = RADIOLIB_NC;
+  _rst = rst;
+  _spi = &spi;
+}
+
+Module::Module(RADIOLIB_PIN_TYPE cs, RADIOLIB_PIN_TYPE int0, RADIOLIB_PIN_TYPE int1, RADIOLIB_PIN_TYPE int2, RADIOLIB_PIN_TYPE rst, SPIClass& spi) {
+  // save pins numbers to private global variables
+  _cs = cs;
+  _int0 = int0;
+  _int1 = int1;
+  _int2 = int2;
   _rst = rst;
   _spi = &spi;
 }
@@ -165,3 +181,55 @@ RADIOLIB_PIN_STATUS Module::digitalRead(RADIOLIB_PIN_TYPE pin) {
   }
   return(LOW);
 }
+
+uint32_t Module::getMicros() {
+  #ifdef LINUX
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return((uint32_t)((uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000));
+  #else
+    return(micros());
+  #endif
+}
+
+void Module::waitUntil(uint32_t timestamp) {
+  #ifdef LINUX
+    // sleep until shortly before the deadline, the rest is spent busy-waiting to hide scheduler wake-up latency
+    int32_t remaining = (int32_t)(timestamp - getMicros());
+    if(remaining > LORALIB_TIMER_SPIN_TIME) {
+      struct timespec ts;
+      clock_gettime(CLOCK_MONOTONIC, &ts);
+      uint64_t wakeup = (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec + (uint64_t)(remaining - LORALIB_TIMER_SPIN_TIME) * 1000;
+      ts.tv_sec = wakeup / 1000000000;
+      ts.tv_nsec = wakeup % 1000000000;
+      while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR);
+    }
+  #else
+    // long waits yield to keep background tasks (e.g. ESP8266 Wi-Fi) running
+    while((int32_t)(timestamp - getMicros()) > 2000) {
+      yield();
+    }
+  #endif
+
+  while((int32_t)(timestamp - getMicros()) > 0);
+}
+
+void TimingStats::reset() {
+  count = 0;
+  minimum = 0;
+  maximum = 0;
+  sumAbs = 0;
+  last = 0;
+}
+
+void TimingStats::add(int32_t deviation) {
+  if((count == 0) || (deviation < minimum)) {
+    minimum = deviation;
+  }
+  if((count == 0) || (deviation > maximum)) {
+    maximum = deviation;
+  }
+  sumAbs += (deviation < 0) ? -deviation : deviation;
+  last = deviation;
+  count++;
+}
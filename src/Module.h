@@ -8,6 +8,9 @@
 #define SPI_READ  0b00000000
 #define SPI_WRITE 0b10000000
 
+// time spent busy-waiting before a deadline, after the thread was woken from sleep (Linux only)
+#define LORALIB_TIMER_SPIN_TIME                       100
+
 #if defined(ESP32) || defined(ESP8266)
   // ESP32/ESP8266 boards (pin 10 conflicts with ESP32/ESP8266 flash connections)
   #define LORALIB_DEFAULT_SPI_CS                      4
@@ -16,6 +19,50 @@
   #define LORALIB_DEFAULT_SPI_CS                      10
 #endif
 
+/*!
+  \struct TimingStats
+
+  \brief Statistics of deviation between scheduled and actual time of timing-critical operations.
+*/
+struct TimingStats {
+  /*!
+    \brief Number of recorded events.
+  */
+  uint32_t count;
+
+  /*!
+    \brief Smallest recorded deviation in microseconds. Negative values mean the event happened early.
+  */
+  int32_t minimum;
+
+  /*!
+    \brief Largest recorded deviation in microseconds.
+  */
+  int32_t maximum;
+
+  /*!
+    \brief Sum of absolute deviations in microseconds, divide by count to get mean jitter.
+  */
+  uint32_t sumAbs;
+
+  /*!
+    \brief Most recent deviation in microseconds.
+  */
+  int32_t last;
+
+  /*!
+    \brief Clears all recorded statistics.
+  */
+  void reset();
+
+  /*!
+    \brief Records a single event.
+
+    \param deviation Difference between actual and scheduled time in microseconds.
+  */
+  void add(int32_t deviation);
+};
+
 /*!
   \class Module
 
@@ -41,6 +88,24 @@ class Module {
     */
     Module(RADIOLIB_PIN_TYPE cs = LORALIB_DEFAULT_SPI_CS, RADIOLIB_PIN_TYPE int0 = 2, RADIOLIB_PIN_TYPE int1 = 3, RADIOLIB_PIN_TYPE rst = RADIOLIB_NC, SPIClass& spi = SPI);
 
+    /*!
+      \brief Constructor with third interrupt/GPIO pin.
+
+      \param cs Arduino pin that will be used as chip select signal for SPI.
+
+      \param int0 Arduino pin that will be used as interrupt/GPIO 0. Connect to SX127x/RFM9x pin DIO0.
+
+      \param int1 Arduino pin that will be used as interrupt/GPIO 1. Connect to SX127x/RFM9x pin DIO1.
+
+      \param int2 Arduino pin that will be used as interrupt/GPIO 2. Connect to SX127x/RFM9x pin DIO2.
+      Used to detect FSK receive timeout without reading IRQ flags (see SX127x::setDio2Action).
+
+      \param rst Arduino pin that will be used connected to the reset pin of the module.
+
+      \param spi SPIClass instance that will be used for SPI bus control. This can be hardware SPI or some software SPI driver.
+    */
+    Module(RADIOLIB_PIN_TYPE cs, RADIOLIB_PIN_TYPE int0, RADIOLIB_PIN_TYPE int1, RADIOLIB_PIN_TYPE int2, RADIOLIB_PIN_TYPE rst, SPIClass& spi = SPI);
+
     /*!
       \brief Initialization method. Called internally when connecting to the %LoRa chip and should not be called explicitly from Arduino code.
 
@@ -165,6 +230,13 @@ class Module {
     */
     RADIOLIB_PIN_TYPE getGpio() const { return(_int1); }
 
+    /*!
+      \brief Access method to get the pin number of third interrupt/GPIO.
+
+      \returns Pin number of interrupt/GPIO configured in the constructor, or RADIOLIB_NC if it was not configured.
+    */
+    RADIOLIB_PIN_TYPE getGpio2() const { return(_int2); }
+
     /*!
       \brief Access method to get the pin number of hardware reset pin.
 
@@ -193,12 +265,27 @@ class Module {
     */
     static RADIOLIB_PIN_STATUS digitalRead(RADIOLIB_PIN_TYPE pin);
 
+    /*!
+      \brief Monotonic microsecond timestamp. Uses CLOCK_MONOTONIC on Linux and Arduino micros() on other platforms.
+      The value overflows after approximately 71 minutes, so only differences between timestamps should be used.
+      \returns Timestamp in microseconds.
+    */
+    static uint32_t getMicros();
+
+    /*!
+      \brief High-resolution wait for a deadline. On Linux, the thread sleeps using clock_nanosleep and busy-waits for the last LORALIB_TIMER_SPIN_TIME microseconds.
+      On other platforms, this is a busy wait.
+      \param timestamp Timestamp (as returned by Module::getMicros) to wait for. Returns immediately if the timestamp is already in the past.
+    */
+    static void waitUntil(uint32_t timestamp);
+
 #ifndef RADIOLIB_GODMODE
   private:
 #endif
     RADIOLIB_PIN_TYPE _cs;
     RADIOLIB_PIN_TYPE _int0;
     RADIOLIB_PIN_TYPE _int1;
+    RADIOLIB_PIN_TYPE _int2;
     RADIOLIB_PIN_TYPE _rst;
 
     SPIClass* _spi;
@@ -519,6 +519,81 @@
 */
 #define ERR_INVALID_ENCODING                  -29
 
+/*!
+  \brief The requested operation requires split FIFO mode, which is currently disabled.
+*/
+#define ERR_FIFO_NOT_SPLIT                    -30
+
+/*!
+  \brief The supplied symbol timeout is invalid.
+*/
+#define ERR_INVALID_SYMBOL_TIMEOUT            -31
+
+/*!
+  \brief Scheduled transmission time has already passed.
+*/
+#define ERR_TX_DEADLINE_MISSED                -32
+
+/*!
+  \brief The supplied receive timeout is invalid.
+*/
+#define ERR_INVALID_RX_TIMEOUT                -33
+
+/*!
+  \brief GPIO lines could not be requested from the operating system.
+*/
+#define ERR_GPIO_UNAVAILABLE                  -34
+
+/*!
+  \brief The supplied RSSI threshold is invalid.
+*/
+#define ERR_INVALID_RSSI_THRESHOLD            -35
+
+/*!
+  \brief No acknowledgement was received after the maximum number of retransmissions.
+*/
+#define ERR_ACK_NOT_RECEIVED                  -36
+
+/*!
+  \brief Received frame has invalid format.
+*/
+#define ERR_INVALID_FRAME                     -37
+
+/*!
+  \brief Delta-compressed frame refers to a previous frame that was not received.
+*/
+#define ERR_DICTIONARY_MISMATCH               -38
+
+/*!
+  \brief Erasure coding block size is out of supported range.
+*/
+#define ERR_INVALID_BLOCK_SIZE                -39
+
+/*!
+  \brief Message integrity check of decrypted payload failed, i.e. the packet was modified, uses a different key or was replayed.
+*/
+#define ERR_MIC_MISMATCH                      -40
+
+/*!
+  \brief Maximum number of radios was already added.
+*/
+#define ERR_TOO_MANY_RADIOS                   -41
+
+/*!
+  \brief No idle radio is available on the requested channel.
+*/
+#define ERR_NO_IDLE_RADIO                     -42
+
+/*!
+  \brief No packet was staged for transmission, or the staged packet was already transmitted.
+*/
+#define ERR_NOTHING_STAGED                    -43
+
+/*!
+  \brief Module is in a mode that does not allow the requested operation.
+*/
+#define ERR_INVALID_MODE                      -44
+
 /*!
   \}
 */
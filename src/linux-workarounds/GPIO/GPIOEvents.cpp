@@ -0,0 +1,146 @@
+#ifdef LINUX
+
+#include "GPIOEvents.h"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/gpio.h>
+
+GPIOEvents::GPIOEvents() {
+  _fd = -1;
+  _numLines = 0;
+  _lastSeqno = 0;
+  _dropped = 0;
+}
+
+GPIOEvents::~GPIOEvents() {
+  end();
+}
+
+int16_t GPIOEvents::begin(const char* chip, const uint32_t* offsets, const uint8_t* edges, uint8_t numLines, uint32_t bufferSize) {
+  // check parameters
+  if((numLines == 0) || (numLines > GPIO_EVENTS_MAX_LINES)) {
+    return(ERR_GPIO_UNAVAILABLE);
+  }
+
+  // release previous request
+  end();
+
+  int chipFd = open(chip, O_RDONLY | O_CLOEXEC);
+  if(chipFd < 0) {
+    return(ERR_GPIO_UNAVAILABLE);
+  }
+
+  // all lines are inputs, edge detection is configured per line using attributes
+  struct gpio_v2_line_request req;
+  memset(&req, 0, sizeof(req));
+  strncpy(req.consumer, "LoRaLib", sizeof(req.consumer) - 1);
+  req.num_lines = numLines;
+  req.event_buffer_size = bufferSize;
+  req.config.flags = GPIO_V2_LINE_FLAG_INPUT;
+  for(uint8_t i = 0; i < numLines; i++) {
+    req.offsets[i] = offsets[i];
+    _offsets[i] = offsets[i];
+
+    uint64_t flags = GPIO_V2_LINE_FLAG_INPUT;
+    if((edges[i] == RISING) || (edges[i] == CHANGE)) {
+      flags |= GPIO_V2_LINE_FLAG_EDGE_RISING;
+    }
+    if((edges[i] == FALLING) || (edges[i] == CHANGE)) {
+      flags |= GPIO_V2_LINE_FLAG_EDGE_FALLING;
+    }
+
+    // lines with the same edge configuration share one attribute
+    uint8_t attr = 0;
+    while((attr < req.config.num_attrs) && (req.config.attrs[attr].attr.flags != flags)) {
+      attr++;
+    }
+    if(attr == req.config.num_attrs) {
+      req.config.attrs[attr].attr.id = GPIO_V2_LINE_ATTR_ID_FLAGS;
+      req.config.attrs[attr].attr.flags = flags;
+      req.config.num_attrs++;
+    }
+    req.config.attrs[attr].mask |= ((uint64_t)1 << i);
+  }
+
+  int ret = ioctl(chipFd, GPIO_V2_GET_LINE_IOCTL, &req);
+  close(chipFd);
+  if(ret < 0) {
+    return(ERR_GPIO_UNAVAILABLE);
+  }
+
+  _fd = req.fd;
+  _numLines = numLines;
+  _lastSeqno = 0;
+  _dropped = 0;
+  return(ERR_NONE);
+}
+
+void GPIOEvents::end() {
+  if(_fd >= 0) {
+    close(_fd);
+    _fd = -1;
+  }
+  _numLines = 0;
+}
+
+int GPIOEvents::read(GPIOEvent* events, size_t maxEvents, int timeout) {
+  if(_fd < 0) {
+    return(-1);
+  }
+
+  // wait for events
+  struct pollfd pfd = { _fd, POLLIN, 0 };
+  int ret = poll(&pfd, 1, timeout);
+  if(ret <= 0) {
+    return(ret);
+  }
+
+  // read as many events as fit, in batches of up to 64
+  struct gpio_v2_line_event buff[64];
+  size_t num = maxEvents < 64 ? maxEvents : 64;
+  ssize_t len = ::read(_fd, buff, num * sizeof(struct gpio_v2_line_event));
+  if(len < 0) {
+    return(-1);
+  }
+
+  num = len / sizeof(struct gpio_v2_line_event);
+  for(size_t i = 0; i < num; i++) {
+    // count events lost in kernel buffer
+    if((_lastSeqno != 0) && (buff[i].seqno != _lastSeqno + 1)) {
+      _dropped += buff[i].seqno - _lastSeqno - 1;
+    }
+    _lastSeqno = buff[i].seqno;
+
+    events[i].timestamp = buff[i].timestamp_ns;
+    events[i].rising = (buff[i].id == GPIO_V2_LINE_EVENT_RISING_EDGE);
+    events[i].seqno = buff[i].seqno;
+    events[i].lineSeqno = buff[i].line_seqno;
+    events[i].line = 0;
+    for(uint8_t l = 0; l < _numLines; l++) {
+      if(_offsets[l] == buff[i].offset) {
+        events[i].line = l;
+        break;
+      }
+    }
+  }
+  return(num);
+}
+
+int GPIOEvents::getValue(uint8_t line) {
+  if((_fd < 0) || (line >= _numLines)) {
+    return(-1);
+  }
+
+  struct gpio_v2_line_values values;
+  values.bits = 0;
+  values.mask = ((uint64_t)1 << line);
+  if(ioctl(_fd, GPIO_V2_LINE_GET_VALUES_IOCTL, &values) < 0) {
+    return(-1);
+  }
+  return((values.bits >> line) & 0x01);
+}
+
+#endif
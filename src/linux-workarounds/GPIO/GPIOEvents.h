@@ -0,0 +1,134 @@
+#ifndef _LORALIB_GPIO_EVENTS_H
+#define _LORALIB_GPIO_EVENTS_H
+
+#ifdef LINUX
+
+#include "../../TypeDef.h"
+
+// maximum number of lines in a single request
+#define GPIO_EVENTS_MAX_LINES                         8
+
+// default kernel event buffer size (events), kernel may clamp this to its own limit
+#define GPIO_EVENTS_BUFFER_SIZE                       1024
+
+/*!
+  \struct GPIOEvent
+
+  \brief Single GPIO edge event, as reported by the kernel.
+*/
+struct GPIOEvent {
+  /*!
+    \brief Kernel timestamp of the edge in nanoseconds (CLOCK_MONOTONIC).
+  */
+  uint64_t timestamp;
+
+  /*!
+    \brief Index of the line in the array passed to GPIOEvents::begin.
+  */
+  uint8_t line;
+
+  /*!
+    \brief Whether this was a rising (true) or falling (false) edge.
+  */
+  bool rising;
+
+  /*!
+    \brief Sequence number of the event across all lines of the request, used to order events from different lines.
+  */
+  uint32_t seqno;
+
+  /*!
+    \brief Sequence number of the event on its own line, gaps mean that events on this line were lost.
+  */
+  uint32_t lineSeqno;
+};
+
+/*!
+  \class GPIOEvents
+
+  \brief Edge event reader using Linux GPIO character device (uAPI v2). All lines are requested at once, so that their events
+  share a single sequence and can be ordered reliably, and are timestamped by the kernel at interrupt time.
+*/
+class GPIOEvents {
+  public:
+    /*!
+      \brief Default constructor.
+    */
+    GPIOEvents();
+
+    /*!
+      \brief Default destructor, releases the lines.
+    */
+    ~GPIOEvents();
+
+    /*!
+      \brief Requests GPIO lines as edge-detecting inputs.
+
+      \param chip Path to GPIO chip device, e.g. "/dev/gpiochip0".
+
+      \param offsets Array of line offsets on the GPIO chip.
+
+      \param edges Array of edges to detect on each line: RISING, FALLING or CHANGE.
+
+      \param numLines Number of lines. Maximum is GPIO_EVENTS_MAX_LINES.
+
+      \param bufferSize Kernel event buffer size in events. Defaults to GPIO_EVENTS_BUFFER_SIZE.
+
+      \returns \ref status_codes
+    */
+    int16_t begin(const char* chip, const uint32_t* offsets, const uint8_t* edges, uint8_t numLines, uint32_t bufferSize = GPIO_EVENTS_BUFFER_SIZE);
+
+    /*!
+      \brief Releases the lines.
+    */
+    void end();
+
+    /*!
+      \brief Reads pending edge events, waiting for at least one event up to the specified timeout.
+
+      \param events Array to save the events to.
+
+      \param maxEvents Size of events array.
+
+      \param timeout Maximum time to wait in milliseconds. Set to -1 to wait indefinitely.
+
+      \returns Number of events read, 0 on timeout or negative value on error.
+    */
+    int read(GPIOEvent* events, size_t maxEvents, int timeout);
+
+    /*!
+      \brief Reads current level of a line.
+
+      \param line Index of the line in the array passed to GPIOEvents::begin.
+
+      \returns Line level (0 or 1), or negative value on error.
+    */
+    int getValue(uint8_t line);
+
+    /*!
+      \brief Gets file descriptor of the line request, e.g. to use with poll/epoll. Readable when events are pending.
+
+      \returns File descriptor, or -1 when no lines are requested.
+    */
+    int getFd() const { return(_fd); }
+
+    /*!
+      \brief Gets number of events lost because the kernel buffer overflowed, detected from gaps in sequence numbers.
+
+      \returns Number of lost events.
+    */
+    uint32_t getDropped() const { return(_dropped); }
+
+#ifndef RADIOLIB_GODMODE
+  private:
+#endif
+    int _fd;
+    uint8_t _numLines;
+    uint32_t _offsets[GPIO_EVENTS_MAX_LINES];
+    uint32_t _lastSeqno;
+    uint32_t _dropped;
+};
+
+#endif
+
+#endif
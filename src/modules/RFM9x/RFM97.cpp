@@ -37,3 +37,8 @@ int16_t RFM97::setSpreadingFactor(uint8_t sf) {
   }
   return(state);
 }
+
+int16_t RFM97::checkSpreadingFactor(uint8_t sf) {
+  RADIOLIB_CHECK_RANGE(sf, 6, 9, ERR_INVALID_SPREADING_FACTOR);
+  return(ERR_NONE);
+}
@@ -35,6 +35,11 @@ class RFM97: public RFM95 {
     */
     int16_t setSpreadingFactor(uint8_t sf);
 
+#ifndef RADIOLIB_GODMODE
+  protected:
+#endif
+    int16_t checkSpreadingFactor(uint8_t sf);
+
 #ifndef RADIOLIB_GODMODE
   private:
 #endif
@@ -82,21 +82,13 @@ int16_t SX1272::setBandwidth(float bw) {
     return(ERR_WRONG_MODEM);
   }
 
-  uint8_t newBandwidth;
-
   // check allowed bandwidth values
-  if(abs(bw - 125.0) <= 0.001) {
-    newBandwidth = SX1272_BW_125_00_KHZ;
-  } else if(abs(bw - 250.0) <= 0.001) {
-    newBandwidth = SX1272_BW_250_00_KHZ;
-  } else if(abs(bw - 500.0) <= 0.001) {
-    newBandwidth = SX1272_BW_500_00_KHZ;
-  } else {
-    return(ERR_INVALID_BANDWIDTH);
-  }
+  uint8_t newBandwidth;
+  int16_t state = SX1272::checkBandwidth(bw, &newBandwidth);
+  RADIOLIB_ASSERT(state);
 
   // set bandwidth and if successful, save the new setting
-  int16_t state = SX1272::setBandwidthRaw(newBandwidth);
+  state = SX1272::setBandwidthRaw(newBandwidth);
   if(state == ERR_NONE) {
     SX127x::_bw = bw;
 
@@ -114,6 +106,20 @@ int16_t SX1272::setBandwidth(float bw) {
   return(state);
 }
 
+int16_t SX1272::checkBandwidth(float bw, uint8_t* newBandwidth) {
+  if(abs(bw - 125.0) <= 0.001) {
+    *newBandwidth = SX1272_BW_125_00_KHZ;
+  } else if(abs(bw - 250.0) <= 0.001) {
+    *newBandwidth = SX1272_BW_250_00_KHZ;
+  } else if(abs(bw - 500.0) <= 0.001) {
+    *newBandwidth = SX1272_BW_500_00_KHZ;
+  } else {
+    return(ERR_INVALID_BANDWIDTH);
+  }
+
+  return(ERR_NONE);
+}
+
 int16_t SX1272::setSpreadingFactor(uint8_t sf) {
   // check active modem
   if(getActiveModem() != SX127X_LORA) {
@@ -231,6 +237,68 @@ int16_t SX1272::setOutputPower(int8_t power) {
   return(state);
 }
 
+int16_t SX1272::buildProfile(uint8_t sf, float bw, uint8_t cr, int8_t power, SX127xProfile& profile) {
+  // check allowed values, spreading factor range depends on the module
+  uint8_t newBandwidth;
+  int16_t state = SX1272::checkBandwidth(bw, &newBandwidth);
+  RADIOLIB_ASSERT(state);
+  state = checkSpreadingFactor(sf);
+  RADIOLIB_ASSERT(state);
+  if((cr < 5) || (cr > 8)) {
+    return(ERR_INVALID_CODING_RATE);
+  }
+  if(!(((power >= -1) && (power <= 17)) || (power == 20))) {
+    return(ERR_INVALID_OUTPUT_POWER);
+  }
+
+  // start from current register values
+  uint8_t modemConfig1 = _mod->SPIreadRegister(SX127X_REG_MODEM_CONFIG_1);
+  uint8_t modemConfig2 = _mod->SPIreadRegister(SX127X_REG_MODEM_CONFIG_2);
+  uint8_t detectOptimize = _mod->SPIreadRegister(SX127X_REG_DETECT_OPTIMIZE);
+  uint8_t paConfig = _mod->SPIreadRegister(SX127X_REG_PA_CONFIG);
+  uint8_t paDac = _mod->SPIreadRegister(SX1272_REG_PA_DAC);
+
+  // bandwidth, coding rate, header mode (implicit header is required for SF6) and low data rate optimization, CRC setting is kept
+  float symbolLength = (float)(uint32_t(1) << sf) / bw;
+  modemConfig1 = newBandwidth | ((cr - 4) << 3) | ((sf == 6) ? SX1272_HEADER_IMPL_MODE : SX1272_HEADER_EXPL_MODE) | (modemConfig1 & 0b00000010) |
+                 ((symbolLength >= 16.0) ? SX1272_LOW_DATA_RATE_OPT_ON : SX1272_LOW_DATA_RATE_OPT_OFF);
+
+  // spreading factor
+  modemConfig2 = (modemConfig2 & 0b00001111) | (sf << 4);
+
+  // detection optimization
+  detectOptimize = (detectOptimize & 0b11111000) | ((sf == 6) ? SX127X_DETECT_OPTIMIZE_SF_6 : SX127X_DETECT_OPTIMIZE_SF_7_12);
+
+  // output power
+  paConfig &= 0b01110000;
+  if(power < 2) {
+    paConfig |= SX127X_PA_SELECT_RFO | (power + 1);
+    paDac = (paDac & 0b11111000) | SX127X_PA_BOOST_OFF;
+  } else if(power <= 17) {
+    paConfig |= SX127X_PA_SELECT_BOOST | (power - 2);
+    paDac = (paDac & 0b11111000) | SX127X_PA_BOOST_OFF;
+  } else {
+    paConfig |= SX127X_PA_SELECT_BOOST | (power - 5);
+    paDac = (paDac & 0b11111000) | SX127X_PA_BOOST_ON;
+  }
+
+  // save the profile
+  profile.sf = sf;
+  profile.bw = bw;
+  profile.cr = cr;
+  profile.power = power;
+  profile.regs[0] = modemConfig1;
+  profile.regs[1] = modemConfig2;
+  profile.regs[2] = 0x00;
+  profile.regs[3] = detectOptimize;
+  profile.regs[4] = (sf == 6) ? SX127X_DETECTION_THRESHOLD_SF_6 : SX127X_DETECTION_THRESHOLD_SF_7_12;
+  profile.regs[5] = paConfig;
+  profile.regs[6] = paDac;
+  profile.modemConfig3Addr = 0;
+  profile.paDacAddr = SX1272_REG_PA_DAC;
+  return(ERR_NONE);
+}
+
 int16_t SX1272::setGain(uint8_t gain) {
   // check active modem
   if(getActiveModem() != SX127X_LORA) {
@@ -348,6 +416,13 @@ float SX1272::getRSSI() {
   }
 }
 
+float SX1272::getCurrentRSSI() {
+  if(getActiveModem() == SX127X_LORA) {
+    return(-139 + _mod->SPIreadRegister(SX127X_REG_RSSI_VALUE));
+  }
+  return((float)_mod->SPIreadRegister(SX127X_REG_RSSI_VALUE_FSK) / -2.0);
+}
+
 int16_t SX1272::setCRC(bool enableCRC) {
   if(getActiveModem() == SX127X_LORA) {
     // set LoRa CRC
@@ -246,6 +246,30 @@ class SX1272: public SX127x {
     */
     float getRSSI();
 
+    /*!
+      \brief Gets instantaneous RSSI with a single register read, without changing operation mode. The module must already be in receive mode.
+
+      \returns Current RSSI level in dBm.
+    */
+    float getCurrentRSSI();
+
+    /*!
+      \brief Precomputes register values for the given %LoRa modem settings and output power, see SX127x::buildProfile.
+
+      \param sf Spreading factor.
+
+      \param bw Bandwidth in kHz.
+
+      \param cr Coding rate denominator.
+
+      \param power Output power in dBm.
+
+      \param profile Structure to save the register values to.
+
+      \returns \ref status_codes
+    */
+    int16_t buildProfile(uint8_t sf, float bw, uint8_t cr, int8_t power, SX127xProfile& profile);
+
     /*!
       \brief Enables/disables CRC check of received packets.
 
@@ -258,6 +282,7 @@ class SX1272: public SX127x {
 #ifndef RADIOLIB_GODMODE
   protected:
 #endif
+    int16_t checkBandwidth(float bw, uint8_t* newBandwidth);
     int16_t setBandwidthRaw(uint8_t newBandwidth);
     int16_t setSpreadingFactorRaw(uint8_t newSpreadingFactor);
     int16_t setCodingRateRaw(uint8_t newCodingRate);
@@ -68,3 +68,8 @@ int16_t SX1273::setSpreadingFactor(uint8_t sf) {
 
   return(state);
 }
+
+int16_t SX1273::checkSpreadingFactor(uint8_t sf) {
+  RADIOLIB_CHECK_RANGE(sf, 6, 9, ERR_INVALID_SPREADING_FACTOR);
+  return(ERR_NONE);
+}
@@ -62,6 +62,11 @@ class SX1273: public SX1272 {
     */
     int16_t setSpreadingFactor(uint8_t sf);
 
+#ifndef RADIOLIB_GODMODE
+  protected:
+#endif
+    int16_t checkSpreadingFactor(uint8_t sf);
+
 #ifndef RADIOLIB_GODMODE
   private:
 #endif
@@ -133,3 +133,8 @@ int16_t SX1277::setSpreadingFactor(uint8_t sf) {
 
   return(state);
 }
+
+int16_t SX1277::checkSpreadingFactor(uint8_t sf) {
+  RADIOLIB_CHECK_RANGE(sf, 6, 9, ERR_INVALID_SPREADING_FACTOR);
+  return(ERR_NONE);
+}
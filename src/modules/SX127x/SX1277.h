@@ -71,6 +71,11 @@ class SX1277: public SX1278 {
     */
     int16_t setSpreadingFactor(uint8_t sf);
 
+#ifndef RADIOLIB_GODMODE
+  protected:
+#endif
+    int16_t checkSpreadingFactor(uint8_t sf);
+
 #ifndef RADIOLIB_GODMODE
   private:
 #endif
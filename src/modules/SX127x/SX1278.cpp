@@ -140,35 +140,13 @@ int16_t SX1278::setBandwidth(float bw) {
     return(ERR_WRONG_MODEM);
   }
 
-  uint8_t newBandwidth;
-
   // check allowed bandwidth values
-  if(abs(bw - 7.8) <= 0.001) {
-    newBandwidth = SX1278_BW_7_80_KHZ;
-  } else if(abs(bw - 10.4) <= 0.001) {
-    newBandwidth = SX1278_BW_10_40_KHZ;
-  } else if(abs(bw - 15.6) <= 0.001) {
-    newBandwidth = SX1278_BW_15_60_KHZ;
-  } else if(abs(bw - 20.8) <= 0.001) {
-    newBandwidth = SX1278_BW_20_80_KHZ;
-  } else if(abs(bw - 31.25) <= 0.001) {
-    newBandwidth = SX1278_BW_31_25_KHZ;
-  } else if(abs(bw - 41.7) <= 0.001) {
-    newBandwidth = SX1278_BW_41_70_KHZ;
-  } else if(abs(bw - 62.5) <= 0.001) {
-    newBandwidth = SX1278_BW_62_50_KHZ;
-  } else if(abs(bw - 125.0) <= 0.001) {
-    newBandwidth = SX1278_BW_125_00_KHZ;
-  } else if(abs(bw - 250.0) <= 0.001) {
-    newBandwidth = SX1278_BW_250_00_KHZ;
-  } else if(abs(bw - 500.0) <= 0.001) {
-    newBandwidth = SX1278_BW_500_00_KHZ;
-  } else {
-    return(ERR_INVALID_BANDWIDTH);
-  }
+  uint8_t newBandwidth;
+  int16_t state = SX1278::checkBandwidth(bw, &newBandwidth);
+  RADIOLIB_ASSERT(state);
 
   // set bandwidth and if successful, save the new setting
-  int16_t state = SX1278::setBandwidthRaw(newBandwidth);
+  state = SX1278::setBandwidthRaw(newBandwidth);
   if(state == ERR_NONE) {
     SX127x::_bw = bw;
 
@@ -186,6 +164,34 @@ int16_t SX1278::setBandwidth(float bw) {
   return(state);
 }
 
+int16_t SX1278::checkBandwidth(float bw, uint8_t* newBandwidth) {
+  if(abs(bw - 7.8) <= 0.001) {
+    *newBandwidth = SX1278_BW_7_80_KHZ;
+  } else if(abs(bw - 10.4) <= 0.001) {
+    *newBandwidth = SX1278_BW_10_40_KHZ;
+  } else if(abs(bw - 15.6) <= 0.001) {
+    *newBandwidth = SX1278_BW_15_60_KHZ;
+  } else if(abs(bw - 20.8) <= 0.001) {
+    *newBandwidth = SX1278_BW_20_80_KHZ;
+  } else if(abs(bw - 31.25) <= 0.001) {
+    *newBandwidth = SX1278_BW_31_25_KHZ;
+  } else if(abs(bw - 41.7) <= 0.001) {
+    *newBandwidth = SX1278_BW_41_70_KHZ;
+  } else if(abs(bw - 62.5) <= 0.001) {
+    *newBandwidth = SX1278_BW_62_50_KHZ;
+  } else if(abs(bw - 125.0) <= 0.001) {
+    *newBandwidth = SX1278_BW_125_00_KHZ;
+  } else if(abs(bw - 250.0) <= 0.001) {
+    *newBandwidth = SX1278_BW_250_00_KHZ;
+  } else if(abs(bw - 500.0) <= 0.001) {
+    *newBandwidth = SX1278_BW_500_00_KHZ;
+  } else {
+    return(ERR_INVALID_BANDWIDTH);
+  }
+
+  return(ERR_NONE);
+}
+
 int16_t SX1278::setSpreadingFactor(uint8_t sf) {
   // check active modem
   if(getActiveModem() != SX127X_LORA) {
@@ -303,6 +309,70 @@ int16_t SX1278::setOutputPower(int8_t power) {
   return(state);
 }
 
+int16_t SX1278::buildProfile(uint8_t sf, float bw, uint8_t cr, int8_t power, SX127xProfile& profile) {
+  // check allowed values, spreading factor range depends on the module
+  uint8_t newBandwidth;
+  int16_t state = SX1278::checkBandwidth(bw, &newBandwidth);
+  RADIOLIB_ASSERT(state);
+  state = checkSpreadingFactor(sf);
+  RADIOLIB_ASSERT(state);
+  if((cr < 5) || (cr > 8)) {
+    return(ERR_INVALID_CODING_RATE);
+  }
+  if(!(((power >= -3) && (power <= 17)) || (power == 20))) {
+    return(ERR_INVALID_OUTPUT_POWER);
+  }
+
+  // start from current register values
+  uint8_t modemConfig1 = _mod->SPIreadRegister(SX127X_REG_MODEM_CONFIG_1);
+  uint8_t modemConfig2 = _mod->SPIreadRegister(SX127X_REG_MODEM_CONFIG_2);
+  uint8_t modemConfig3 = _mod->SPIreadRegister(SX1278_REG_MODEM_CONFIG_3);
+  uint8_t detectOptimize = _mod->SPIreadRegister(SX127X_REG_DETECT_OPTIMIZE);
+  uint8_t paDac = _mod->SPIreadRegister(SX1278_REG_PA_DAC);
+
+  // bandwidth, coding rate and header mode (implicit header is required for SF6)
+  modemConfig1 = newBandwidth | ((cr - 4) << 1) | ((sf == 6) ? SX1278_HEADER_IMPL_MODE : SX1278_HEADER_EXPL_MODE);
+
+  // spreading factor
+  modemConfig2 = (modemConfig2 & 0b00001111) | (sf << 4);
+
+  // low data rate optimization
+  float symbolLength = (float)(uint32_t(1) << sf) / bw;
+  modemConfig3 = (modemConfig3 & 0b11110111) | ((symbolLength >= 16.0) ? SX1278_LOW_DATA_RATE_OPT_ON : SX1278_LOW_DATA_RATE_OPT_OFF);
+
+  // detection optimization
+  detectOptimize = (detectOptimize & 0b11111000) | ((sf == 6) ? SX127X_DETECT_OPTIMIZE_SF_6 : SX127X_DETECT_OPTIMIZE_SF_7_12);
+
+  // output power
+  uint8_t paConfig;
+  if(power < 2) {
+    paConfig = SX127X_PA_SELECT_RFO | SX1278_LOW_POWER | (power + 3);
+    paDac = (paDac & 0b11111000) | SX127X_PA_BOOST_OFF;
+  } else if(power <= 17) {
+    paConfig = SX127X_PA_SELECT_BOOST | SX1278_MAX_POWER | (power - 2);
+    paDac = (paDac & 0b11111000) | SX127X_PA_BOOST_OFF;
+  } else {
+    paConfig = SX127X_PA_SELECT_BOOST | SX1278_MAX_POWER | (power - 5);
+    paDac = (paDac & 0b11111000) | SX127X_PA_BOOST_ON;
+  }
+
+  // save the profile
+  profile.sf = sf;
+  profile.bw = bw;
+  profile.cr = cr;
+  profile.power = power;
+  profile.regs[0] = modemConfig1;
+  profile.regs[1] = modemConfig2;
+  profile.regs[2] = modemConfig3;
+  profile.regs[3] = detectOptimize;
+  profile.regs[4] = (sf == 6) ? SX127X_DETECTION_THRESHOLD_SF_6 : SX127X_DETECTION_THRESHOLD_SF_7_12;
+  profile.regs[5] = paConfig;
+  profile.regs[6] = paDac;
+  profile.modemConfig3Addr = SX1278_REG_MODEM_CONFIG_3;
+  profile.paDacAddr = SX1278_REG_PA_DAC;
+  return(ERR_NONE);
+}
+
 int16_t SX1278::setGain(uint8_t gain) {
   // check active modem
   if(getActiveModem() != SX127X_LORA) {
@@ -426,6 +496,17 @@ float SX1278::getRSSI() {
   }
 }
 
+float SX1278::getCurrentRSSI() {
+  if(getActiveModem() == SX127X_LORA) {
+    // RSSI calculation uses different constant for low-frequency and high-frequency ports
+    if(_freq < 868.0) {
+      return(-164 + _mod->SPIreadRegister(SX127X_REG_RSSI_VALUE));
+    }
+    return(-157 + _mod->SPIreadRegister(SX127X_REG_RSSI_VALUE));
+  }
+  return((float)_mod->SPIreadRegister(SX127X_REG_RSSI_VALUE_FSK) / -2.0);
+}
+
 int16_t SX1278::setCRC(bool enableCRC) {
   if(getActiveModem() == SX127X_LORA) {
     // set LoRa CRC
@@ -3,6 +3,34 @@
 SX127x::SX127x(Module* mod) : PhysicalLayer(SX127X_FREQUENCY_STEP_SIZE, SX127X_MAX_PACKET_LENGTH) {
   _mod = mod;
   _packetLengthQueried = false;
+  _fifoSplit = false;
+  _staged = false;
+  _stagedLength = 0;
+  _stagedDioMapping = SX127X_DIO0_TX_DONE;
+  _stagedOpMode = SX127X_LORA | SX127X_TX;
+  _scheduleJitter.reset();
+  _toneJitter.reset();
+  _lbtMaxAttempts = 8;
+  _lbtSlotLength = 0;
+  _lbtMaxExponent = 6;
+  _lbtSeed = 0;
+  _preambleLength = 0;
+  _hopPeriod = SX127X_HOP_PERIOD_OFF;
+  _hopTable = NULL;
+  _hopChannels = 0;
+  _streamData = NULL;
+  _streamLen = 0;
+  _streamPacketLen = 0;
+  _streamPos = 0;
+  _streamActive = false;
+  _streamTx = false;
+  _streamHeader = 0;
+  _streamHeaderLen = 0;
+  _streamSync = false;
+  _rxTimeoutConfigured = false;
+  _autoRestartRx = false;
+  _rssiSmoothing = 2;
+  _cipher = NULL;
 }
 
 int16_t SX127x::begin(uint8_t chipVersion, uint8_t syncWord, uint8_t currentLimit, uint16_t preambleLength) {
@@ -10,6 +38,7 @@ int16_t SX127x::begin(uint8_t chipVersion, uint8_t syncWord, uint8_t currentLimi
   _mod->init(RADIOLIB_USE_SPI);
   Module::pinMode(_mod->getIrq(), INPUT);
   Module::pinMode(_mod->getGpio(), INPUT);
+  Module::pinMode(_mod->getGpio2(), INPUT);
 
   // try to find the SX127x chip
   if(!SX127x::findChip(chipVersion)) {
@@ -45,6 +74,8 @@ int16_t SX127x::begin(uint8_t chipVersion, uint8_t syncWord, uint8_t currentLimi
 
   // initialize internal variables
   _dataRate = 0.0;
+  _fifoSplit = false;
+  _staged = false;
 
   return(state);
 }
@@ -53,6 +84,7 @@ int16_t SX127x::beginFSK(uint8_t chipVersion, float br, float freqDev, float rxB
   // set module properties
   _mod->init(RADIOLIB_USE_SPI);
   Module::pinMode(_mod->getIrq(), INPUT);
+  Module::pinMode(_mod->getGpio2(), INPUT);
 
   // try to find the SX127x chip
   if(!SX127x::findChip(chipVersion)) {
@@ -126,16 +158,7 @@ int16_t SX127x::transmit(uint8_t* data, size_t len, uint8_t addr) {
   uint32_t start = 0;
   if(modem == SX127X_LORA) {
     // calculate timeout (150 % of expected time-one-air)
-    float symbolLength = (float)(uint32_t(1) <<_sf) / (float)_bw;
-    float de = 0;
-    if(symbolLength >= 16.0) {
-      de = 1;
-    }
-    float ih = (float)_mod->SPIgetRegValue(SX127X_REG_MODEM_CONFIG_1, 0, 0);
-    float crc = (float)(_mod->SPIgetRegValue(SX127X_REG_MODEM_CONFIG_2, 2, 2) >> 2);
-    float n_pre = (float)((_mod->SPIgetRegValue(SX127X_REG_PREAMBLE_MSB) << 8) | _mod->SPIgetRegValue(SX127X_REG_PREAMBLE_LSB));
-    float n_pay = 8.0 + max(ceil((8.0 * (float)len - 4.0 * (float)_sf + 28.0 + 16.0 * crc - 20.0 * ih)/(4.0 * (float)_sf - 8.0 * de)) * (float)_cr, 0.0);
-    uint32_t timeout = ceil(symbolLength * (n_pre + n_pay + 4.25) * 1500.0);
+    uint32_t timeout = getTimeOnAir(len) * 1.5;
 
     // start transmission
     state = startTransmit(data, len, addr);
@@ -145,6 +168,9 @@ int16_t SX127x::transmit(uint8_t* data, size_t len, uint8_t addr) {
     start = micros();
     while(!Module::digitalRead(_mod->getIrq())) {
       yield();
+      if((_hopPeriod != SX127X_HOP_PERIOD_OFF) && Module::digitalRead(_mod->getGpio())) {
+        fhssChangeChannel();
+      }
       if(micros() - start > timeout) {
         clearIRQFlags();
         return(ERR_TX_TIMEOUT);
@@ -159,16 +185,21 @@ int16_t SX127x::transmit(uint8_t* data, size_t len, uint8_t addr) {
     state = startTransmit(data, len, addr);
     RADIOLIB_ASSERT(state);
 
-    // wait for transmission end or timeout
+    // wait for transmission end or timeout, keep FIFO filled for long packets
     start = micros();
     while(!Module::digitalRead(_mod->getIrq())) {
       yield();
+      if(_streamActive) {
+        fifoService();
+      }
       if(micros() - start > timeout) {
+        finishStream();
         clearIRQFlags();
         standby();
         return(ERR_TX_TIMEOUT);
       }
     }
+    fifoService();
   } else {
     return(ERR_UNKNOWN);
   }
@@ -197,7 +228,17 @@ int16_t SX127x::receive(uint8_t* data, size_t len) {
     // wait for packet reception or timeout (100 LoRa symbols)
     while(!Module::digitalRead(_mod->getIrq())) {
       yield();
-      if(Module::digitalRead(_mod->getGpio())) {
+      if(_hopPeriod != SX127X_HOP_PERIOD_OFF) {
+        // DIO1 is used for channel changes, so timeout has to be read from IRQ flags
+        uint8_t flags = _mod->SPIreadRegister(SX127X_REG_IRQ_FLAGS);
+        if(flags & SX127X_CLEAR_IRQ_FLAG_FHSS_CHANGE_CHANNEL) {
+          fhssChangeChannel();
+        }
+        if(flags & SX127X_CLEAR_IRQ_FLAG_RX_TIMEOUT) {
+          clearIRQFlags();
+          return(ERR_RX_TIMEOUT);
+        }
+      } else if(Module::digitalRead(_mod->getGpio())) {
         clearIRQFlags();
         return(ERR_RX_TIMEOUT);
       }
@@ -206,26 +247,279 @@ int16_t SX127x::receive(uint8_t* data, size_t len) {
   } else if(modem == SX127X_FSK_OOK) {
     // calculate timeout (500 % of expected time-one-air)
     uint32_t timeout = (uint32_t)((((float)(len * 8)) / (_br * 1000.0)) * 5000000.0);
+    return(receiveFSK(data, len, timeout));
+  }
 
-    // set mode to receive
-    state = startReceive(len, SX127X_RX);
+  // read the received data
+  state = readData(data, len);
+
+  return(state);
+}
+
+int16_t SX127x::receive(uint8_t* data, size_t len, uint32_t timeout) {
+  int16_t modem = getActiveModem();
+  if(modem == SX127X_FSK_OOK) {
+    return(receiveFSK(data, len, timeout));
+  } else if(modem != SX127X_LORA) {
+    return(ERR_WRONG_MODEM);
+  }
+
+  // preamble has to be detected within symbol timeout, longer timeouts are covered by repeated reception
+  uint32_t symbolLength = ((uint32_t)1 << _sf) * 1000.0 / _bw;
+  uint32_t symbols = (timeout + symbolLength - 1) / symbolLength;
+  if(symbols < 4) {
+    symbols = 4;
+  } else if(symbols > 1023) {
+    symbols = 1023;
+  }
+
+  // save configured symbol timeout, so that it can be restored afterwards
+  uint8_t prevMsb = _mod->SPIgetRegValue(SX127X_REG_MODEM_CONFIG_2, 1, 0);
+  uint8_t prevLsb = _mod->SPIreadRegister(SX127X_REG_SYMB_TIMEOUT_LSB);
+  int16_t state = setSymbolTimeout(symbols);
+  RADIOLIB_ASSERT(state);
+
+  uint32_t start = Module::getMicros();
+  do {
+    state = receive(data, len);
+  } while((state == ERR_RX_TIMEOUT) && (Module::getMicros() - start < timeout));
+
+  _mod->SPIsetRegValue(SX127X_REG_MODEM_CONFIG_2, prevMsb, 1, 0);
+  _mod->SPIsetRegValue(SX127X_REG_SYMB_TIMEOUT_LSB, prevLsb);
+  return(state);
+}
+
+int16_t SX127x::transmitReceive(uint8_t* txData, size_t txLen, uint8_t* rxData, size_t rxLen, uint32_t rxDelay) {
+  // check active modem
+  if(getActiveModem() != SX127X_LORA) {
+    return(ERR_WRONG_MODEM);
+  }
+
+  // set mode to standby
+  int16_t state = setMode(SX127X_STANDBY);
+  RADIOLIB_ASSERT(state);
+
+  // calculate timeout (150 % of expected time-one-air)
+  uint32_t timeOnAir = getTimeOnAir(txLen);
+  uint32_t timeout = timeOnAir * 1.5;
+
+  // set receive FIFO pointers, these are not touched by transmission
+  uint8_t rxBase = _fifoSplit ? SX127X_FIFO_RX_BASE_ADDR_SPLIT : SX127X_FIFO_RX_BASE_ADDR_MAX;
+  state = _mod->SPIsetRegValue(SX127X_REG_FIFO_RX_BASE_ADDR, rxBase);
+  RADIOLIB_ASSERT(state);
+
+  // precompute receiver register values, so that the window can be opened with raw writes only
+  bool hopping = (_hopPeriod != SX127X_HOP_PERIOD_OFF);
+  uint8_t rxDioMapping = (_mod->SPIreadRegister(SX127X_REG_DIO_MAPPING_1) & 0b00001111) | SX127X_DIO0_RX_DONE;
+  rxDioMapping |= hopping ? SX127X_DIO1_FHSS_CHANGE_CHANNEL : SX127X_DIO1_RX_TIMEOUT;
+  uint8_t rxOpMode = (_mod->SPIreadRegister(SX127X_REG_OP_MODE) & 0b11111000) | SX127X_RXSINGLE;
+
+  // start transmission
+  state = startTransmit(txData, txLen);
+  RADIOLIB_ASSERT(state);
+
+  // sleep through most of the expected time-on-air (unless channel changes have to be serviced), then poll for transmission end
+  uint32_t start = Module::getMicros();
+  if(!hopping) {
+    Module::waitUntil(start + timeOnAir - timeOnAir/8);
+  }
+  while(!Module::digitalRead(_mod->getIrq())) {
+    if(hopping && Module::digitalRead(_mod->getGpio())) {
+      fhssChangeChannel();
+    }
+    if(Module::getMicros() - start > timeout) {
+      clearIRQFlags();
+      standby();
+      return(ERR_TX_TIMEOUT);
+    }
+  }
+
+  // TxDone timestamp is the reference for the receive window
+  uint32_t txDone = Module::getMicros();
+  _dataRate = (txLen*8.0)/((float)(txDone - start)/1000000.0);
+
+  // module is back in standby, configure the receiver
+  _mod->SPIwriteRegister(SX127X_REG_DIO_MAPPING_1, rxDioMapping);
+  _mod->SPIwriteRegister(SX127X_REG_IRQ_FLAGS, 0b11111111);
+  _mod->SPIwriteRegister(SX127X_REG_FIFO_ADDR_PTR, rxBase);
+  if(_sf == 6) {
+    _mod->SPIwriteRegister(SX127X_REG_PAYLOAD_LENGTH, rxLen);
+  }
+  if(hopping) {
+    writeFrf(_hopTable[0]);
+  }
+
+  // open the receive window
+  Module::waitUntil(txDone + rxDelay);
+  _mod->SPIwriteRegister(SX127X_REG_OP_MODE, rxOpMode);
+
+  // wait for packet reception or timeout
+  while(!Module::digitalRead(_mod->getIrq())) {
+    if(hopping) {
+      // DIO1 is used for channel changes, so timeout has to be read from IRQ flags
+      uint8_t flags = _mod->SPIreadRegister(SX127X_REG_IRQ_FLAGS);
+      if(flags & SX127X_CLEAR_IRQ_FLAG_FHSS_CHANGE_CHANNEL) {
+        fhssChangeChannel();
+      }
+      if(flags & SX127X_CLEAR_IRQ_FLAG_RX_TIMEOUT) {
+        clearIRQFlags();
+        return(ERR_RX_TIMEOUT);
+      }
+    } else if(Module::digitalRead(_mod->getGpio())) {
+      clearIRQFlags();
+      return(ERR_RX_TIMEOUT);
+    }
+  }
+
+  // read the received data
+  return(readData(rxData, rxLen));
+}
+
+int16_t SX127x::receiveDutyCycle(uint8_t* data, size_t len, uint32_t timeout) {
+  // set mode to standby
+  int16_t state = setMode(SX127X_STANDBY);
+  RADIOLIB_ASSERT(state);
+
+  int16_t modem = getActiveModem();
+  if(modem == SX127X_LORA) {
+    // sniff period is derived from preamble length, leaving enough preamble symbols for the receiver to lock after detection
+    if(_preambleLength <= SX127X_CAD_SNIFF_MARGIN) {
+      return(ERR_INVALID_PREAMBLE_LENGTH);
+    }
+    uint32_t symbolLength = ((uint32_t)1 << _sf) * 1000.0 / _bw;
+    uint32_t sleepTime = (_preambleLength - SX127X_CAD_SNIFF_MARGIN) * symbolLength;
+    uint32_t cadTimeout = 16 * symbolLength;
+
+    // save symbol timeout, receive window after detection must cover the rest of the preamble
+    uint8_t modemConfig2 = _mod->SPIreadRegister(SX127X_REG_MODEM_CONFIG_2);
+    uint8_t symbTimeout = _mod->SPIreadRegister(SX127X_REG_SYMB_TIMEOUT_LSB);
+    uint16_t rxSymbols = _preambleLength + SX127X_CAD_SNIFF_MARGIN;
+    if(rxSymbols > 1023) {
+      rxSymbols = 1023;
+    }
+    state = setSymbolTimeout(rxSymbols);
+    RADIOLIB_ASSERT(state);
+    uint32_t rxTimeout = (rxSymbols + _preambleLength + 4) * symbolLength + getTimeOnAir(len);
+
+    // set expected packet length for SF6
+    if(_sf == 6) {
+      state = _mod->SPIsetRegValue(SX127X_REG_PAYLOAD_LENGTH, len);
+      RADIOLIB_ASSERT(state);
+    }
+
+    // set FIFO pointers
+    uint8_t rxBase = _fifoSplit ? SX127X_FIFO_RX_BASE_ADDR_SPLIT : SX127X_FIFO_RX_BASE_ADDR_MAX;
+    state = _mod->SPIsetRegValue(SX127X_REG_FIFO_RX_BASE_ADDR, rxBase);
+    RADIOLIB_ASSERT(state);
+
+    // precompute register values
+    uint8_t dioMapping = _mod->SPIreadRegister(SX127X_REG_DIO_MAPPING_1) & 0b00001111;
+    uint8_t dioMappingCad = dioMapping | SX127X_DIO0_CAD_DONE | SX127X_DIO1_CAD_DETECTED;
+    uint8_t dioMappingRx = dioMapping | SX127X_DIO0_RX_DONE | SX127X_DIO1_RX_TIMEOUT;
+    uint8_t opMode = _mod->SPIreadRegister(SX127X_REG_OP_MODE) & 0b11111000;
+
+    state = ERR_RX_TIMEOUT;
+    uint32_t start = Module::getMicros();
+    while((timeout == 0) || (Module::getMicros() - start < timeout)) {
+      // wake up and check for preamble
+      _mod->SPIwriteRegister(SX127X_REG_DIO_MAPPING_1, dioMappingCad);
+      _mod->SPIwriteRegister(SX127X_REG_IRQ_FLAGS, 0b11111111);
+      _mod->SPIwriteRegister(SX127X_REG_OP_MODE, opMode | SX127X_CAD);
+      uint8_t flags = waitForIrq(SX127X_CLEAR_IRQ_FLAG_CAD_DONE, cadTimeout);
+      if(!flags) {
+        state = ERR_UNKNOWN;
+        break;
+      }
+
+      if(flags & SX127X_CLEAR_IRQ_FLAG_CAD_DETECTED) {
+        // preamble detected, switch to single receive
+        _mod->SPIwriteRegister(SX127X_REG_DIO_MAPPING_1, dioMappingRx);
+        _mod->SPIwriteRegister(SX127X_REG_IRQ_FLAGS, 0b11111111);
+        _mod->SPIwriteRegister(SX127X_REG_FIFO_ADDR_PTR, rxBase);
+        _mod->SPIwriteRegister(SX127X_REG_OP_MODE, opMode | SX127X_RXSINGLE);
+
+        // wait for packet reception or timeout, a timeout means false detection and sniffing continues
+        flags = waitForIrq(SX127X_CLEAR_IRQ_FLAG_RX_DONE | SX127X_CLEAR_IRQ_FLAG_RX_TIMEOUT, rxTimeout);
+        if(flags & SX127X_CLEAR_IRQ_FLAG_RX_DONE) {
+          state = readData(data, len);
+          break;
+        }
+      }
+
+      // go back to sleep until the next sniff
+      _mod->SPIwriteRegister(SX127X_REG_OP_MODE, opMode | SX127X_SLEEP);
+      Module::waitUntil(Module::getMicros() + sleepTime);
+    }
+
+    // restore symbol timeout
+    clearIRQFlags();
+    standby();
+    _mod->SPIwriteRegister(SX127X_REG_MODEM_CONFIG_2, modemConfig2);
+    _mod->SPIwriteRegister(SX127X_REG_SYMB_TIMEOUT_LSB, symbTimeout);
+    return(state);
+
+  } else if(modem == SX127X_FSK_OOK) {
+    // let the sequencer duty-cycle the receiver
+    state = startReceiveDutyCycle();
     RADIOLIB_ASSERT(state);
 
     // wait for packet reception or timeout
-    uint32_t start = micros();
+    uint32_t start = Module::getMicros();
     while(!Module::digitalRead(_mod->getIrq())) {
       yield();
-      if(micros() - start > timeout) {
+      if((timeout != 0) && (Module::getMicros() - start > timeout)) {
+        _mod->SPIwriteRegister(SX127X_REG_SEQ_CONFIG_1, SX127X_SEQUENCER_STOP);
         clearIRQFlags();
+        standby();
         return(ERR_RX_TIMEOUT);
       }
     }
+
+    // read the received data
+    return(readData(data, len));
   }
 
-  // read the received data
-  state = readData(data, len);
+  return(ERR_UNKNOWN);
+}
 
-  return(state);
+int16_t SX127x::startReceiveDutyCycle() {
+  // check active modem
+  if(getActiveModem() != SX127X_FSK_OOK) {
+    return(ERR_WRONG_MODEM);
+  }
+
+  // receive window must fit preamble detection and receiver start-up, the rest of the preamble is slept through
+  uint32_t preambleTime = (uint32_t)_preambleLength * 8000.0 / _br;
+  uint32_t rxWindow = SX127X_SEQ_RX_WINDOW_BYTES * 8000.0 / _br + SX127X_SEQ_RX_STARTUP_TIME;
+  if(preambleTime < rxWindow + SX127X_SEQ_RX_STARTUP_TIME + 64) {
+    return(ERR_INVALID_PREAMBLE_LENGTH);
+  }
+  uint32_t sleepTime = preambleTime - rxWindow - SX127X_SEQ_RX_STARTUP_TIME;
+
+  // set mode to standby
+  int16_t state = setMode(SX127X_STANDBY);
+  RADIOLIB_ASSERT(state);
+
+  // set DIO pin mapping
+  state = _mod->SPIsetRegValue(SX127X_REG_DIO_MAPPING_1, SX127X_DIO0_PACK_PAYLOAD_READY, 7, 6);
+  RADIOLIB_ASSERT(state);
+
+  // set sleep (timer 1) and receive window (timer 2) duration
+  state = setSequencerTimer(1, sleepTime);
+  state |= setSequencerTimer(2, rxWindow);
+  RADIOLIB_ASSERT(state);
+
+  // idle in sleep, wake to receive, go back to idle on timeout and stop after packet was received
+  state = _mod->SPIsetRegValue(SX127X_REG_SEQ_CONFIG_2, SX127X_FROM_RECEIVE_PACKET_RECEIVED_PAYLOAD | SX127X_FROM_RX_TIMEOUT_LP_SELECTION | SX127X_FROM_PACKET_RECEIVED_SEQ_OFF);
+  state |= _mod->SPIsetRegValue(SX127X_REG_SEQ_CONFIG_1, SX127X_IDLE_MODE_SLEEP | SX127X_FROM_START_LP_SELECTION | SX127X_LP_SELECTION_IDLE | SX127X_FROM_IDLE_RECEIVE | SX127X_FROM_TRANSMIT_LP_SELECTION, 5, 0);
+  RADIOLIB_ASSERT(state);
+
+  // clear interrupt flags
+  clearIRQFlags();
+
+  // start sequencer
+  _mod->SPIwriteRegister(SX127X_REG_SEQ_CONFIG_1, _mod->SPIreadRegister(SX127X_REG_SEQ_CONFIG_1) | SX127X_SEQUENCER_START);
+  return(ERR_NONE);
 }
 
 int16_t SX127x::scanChannel() {
@@ -264,6 +558,124 @@ int16_t SX127x::scanChannel() {
   return(CHANNEL_FREE);
 }
 
+int16_t SX127x::scanActivity(const uint32_t* frf, uint8_t numChannels, const uint8_t* sf, uint8_t numSf, uint8_t* activity) {
+  // check active modem
+  if(getActiveModem() != SX127X_LORA) {
+    return(ERR_WRONG_MODEM);
+  }
+
+  // check parameters
+  if(numSf > 8) {
+    return(ERR_INVALID_SPREADING_FACTOR);
+  }
+  for(uint8_t i = 0; i < numSf; i++) {
+    RADIOLIB_CHECK_RANGE(sf[i], 7, 12, ERR_INVALID_SPREADING_FACTOR);
+  }
+
+  // set mode to standby
+  int16_t state = setMode(SX127X_STANDBY);
+  RADIOLIB_ASSERT(state);
+
+  // save current configuration
+  uint8_t frfOrig[3];
+  _mod->SPIreadRegisterBurst(SX127X_REG_FRF_MSB, 3, frfOrig);
+  uint8_t modemConfig2 = _mod->SPIreadRegister(SX127X_REG_MODEM_CONFIG_2);
+  uint8_t dioMapping = _mod->SPIreadRegister(SX127X_REG_DIO_MAPPING_1);
+  uint8_t opMode = _mod->SPIreadRegister(SX127X_REG_OP_MODE) & 0b11111000;
+
+  // set DIO pin mapping
+  _mod->SPIwriteRegister(SX127X_REG_DIO_MAPPING_1, (dioMapping & 0b00001111) | SX127X_DIO0_CAD_DONE | SX127X_DIO1_CAD_DETECTED);
+
+  for(uint8_t i = 0; i < numChannels; i++) {
+    activity[i] = 0;
+  }
+
+  uint8_t frfLast[3] = { frfOrig[0], frfOrig[1], frfOrig[2] };
+  uint8_t sfLast = modemConfig2 >> 4;
+  for(uint8_t n = 0; n < numSf; n++) {
+    // set spreading factor
+    if(sf[n] != sfLast) {
+      _mod->SPIwriteRegister(SX127X_REG_MODEM_CONFIG_2, (modemConfig2 & 0x0F) | (sf[n] << 4));
+      sfLast = sf[n];
+    }
+    uint32_t cadTimeout = 16 * (((uint32_t)1 << sf[n]) * 1000.0 / _bw);
+
+    for(uint8_t i = 0; i < numChannels; i++) {
+      // set frequency, new value is only applied after LSB was written, so write from the first changed byte up to LSB
+      uint8_t frfNew[3] = { (uint8_t)((frf[i] >> 16) & 0xFF), (uint8_t)((frf[i] >> 8) & 0xFF), (uint8_t)(frf[i] & 0xFF) };
+      uint8_t first = 0;
+      while((first < 3) && (frfNew[first] == frfLast[first])) {
+        first++;
+      }
+      if(first < 3) {
+        _mod->SPIwriteRegisterBurst(SX127X_REG_FRF_MSB + first, frfNew + first, 3 - first);
+        frfLast[0] = frfNew[0];
+        frfLast[1] = frfNew[1];
+        frfLast[2] = frfNew[2];
+      }
+
+      // run channel activity detection
+      _mod->SPIwriteRegister(SX127X_REG_IRQ_FLAGS, 0b11111111);
+      _mod->SPIwriteRegister(SX127X_REG_OP_MODE, opMode | SX127X_CAD);
+      uint8_t flags = waitForIrq(SX127X_CLEAR_IRQ_FLAG_CAD_DONE, cadTimeout);
+      if(!flags) {
+        state = ERR_UNKNOWN;
+        break;
+      }
+      if(flags & SX127X_CLEAR_IRQ_FLAG_CAD_DETECTED) {
+        activity[i] |= (1 << n);
+      }
+    }
+    if(state != ERR_NONE) {
+      break;
+    }
+  }
+
+  // restore original configuration
+  clearIRQFlags();
+  standby();
+  _mod->SPIwriteRegisterBurst(SX127X_REG_FRF_MSB, frfOrig, 3);
+  state |= _mod->SPIsetRegValue(SX127X_REG_MODEM_CONFIG_2, modemConfig2);
+  state |= _mod->SPIsetRegValue(SX127X_REG_DIO_MAPPING_1, dioMapping);
+  return(state);
+}
+
+int16_t SX127x::sweepRSSI(const uint32_t* frf, uint16_t numChannels, float* rssi) {
+  // check active modem
+  if(getActiveModem() != SX127X_FSK_OOK) {
+    return(ERR_WRONG_MODEM);
+  }
+
+  // save original frequency
+  uint8_t frfOrig[3];
+  _mod->SPIreadRegisterBurst(SX127X_REG_FRF_MSB, 3, frfOrig);
+
+  // RSSI is averaged over 2^(smoothing + 1) samples, taken at 4x receiver bandwidth
+  uint32_t settleTime = SX127X_SWEEP_PLL_LOCK_TIME + (uint32_t)((250.0 * (float)(2 << _rssiSmoothing)) / _rxBw) + 1;
+
+  // precompute receiver restart
+  uint8_t rxConfig = (_mod->SPIreadRegister(SX127X_REG_RX_CONFIG) & 0b10011111) | SX127X_RESTART_RX_WITH_PLL_LOCK;
+
+  // start receiver once for the whole sweep
+  int16_t state = setMode(SX127X_RX);
+  RADIOLIB_ASSERT(state);
+
+  for(uint16_t i = 0; i < numChannels; i++) {
+    // retune and restart receiver, fast hop is enabled in FSK mode
+    writeFrf(frf[i]);
+    _mod->SPIwriteRegister(SX127X_REG_RX_CONFIG, rxConfig);
+
+    // wait for new RSSI value
+    Module::waitUntil(Module::getMicros() + settleTime);
+    rssi[i] = (float)_mod->SPIreadRegister(SX127X_REG_RSSI_VALUE_FSK) / -2.0;
+  }
+
+  // restore original frequency
+  standby();
+  _mod->SPIwriteRegisterBurst(SX127X_REG_FRF_MSB, frfOrig, 3);
+  return(ERR_NONE);
+}
+
 int16_t SX127x::sleep() {
   // set mode to sleep
   return(setMode(SX127X_SLEEP));
@@ -282,9 +694,7 @@ int16_t SX127x::transmitDirect(uint32_t FRF) {
 
   // user requested to start transmitting immediately (required for RTTY)
   if(FRF != 0) {
-    _mod->SPIwriteRegister(SX127X_REG_FRF_MSB, (FRF & 0xFF0000) >> 16);
-    _mod->SPIwriteRegister(SX127X_REG_FRF_MID, (FRF & 0x00FF00) >> 8);
-    _mod->SPIwriteRegister(SX127X_REG_FRF_LSB, FRF & 0x0000FF);
+    writeFrf(FRF);
 
     return(setMode(SX127X_TX));
   }
@@ -297,6 +707,49 @@ int16_t SX127x::transmitDirect(uint32_t FRF) {
   return(setMode(SX127X_TX));
 }
 
+int16_t SX127x::transmitDirectTones(const uint8_t* symbols, size_t len, const SX127xChannelTable& tones, uint32_t symbolLength) {
+  // check modem
+  if(getActiveModem() != SX127X_FSK_OOK) {
+    return(ERR_WRONG_MODEM);
+  }
+
+  // check all symbols are in the tone table before keying starts
+  for(size_t i = 0; i < len; i++) {
+    if(symbols[i] >= tones.getNumChannels()) {
+      return(ERR_INVALID_FREQUENCY);
+    }
+  }
+  if(len == 0) {
+    return(ERR_NONE);
+  }
+
+  // start transmitting at the first tone
+  writeFrf(tones.getFrf(symbols[0]));
+  int16_t state = setMode(SX127X_TX);
+  RADIOLIB_ASSERT(state);
+
+  // symbol boundaries are computed from start, so that timing errors do not accumulate
+  uint32_t start = Module::getMicros();
+  for(size_t i = 1; i < len; i++) {
+    uint32_t boundary = start + i * symbolLength;
+    Module::waitUntil(boundary);
+    uint32_t fired = Module::getMicros();
+
+    // only change the tone when needed
+    if(symbols[i] != symbols[i - 1]) {
+      _mod->SPIwriteRegisterBurst(SX127X_REG_FRF_MSB, (uint8_t*)tones.getFrfBytes(symbols[i]), 3);
+    }
+
+    // record achieved timing
+    _toneJitter.add((int32_t)(fired - boundary));
+  }
+
+  // wait for the last symbol to finish
+  Module::waitUntil(start + len * symbolLength);
+
+  return(ERR_NONE);
+}
+
 int16_t SX127x::receiveDirect() {
   // check modem
   if(getActiveModem() != SX127X_FSK_OOK) {
@@ -340,7 +793,12 @@ int16_t SX127x::startReceive(uint8_t len, uint8_t mode) {
   int16_t modem = getActiveModem();
   if(modem == SX127X_LORA) {
     // set DIO pin mapping
-    state |= _mod->SPIsetRegValue(SX127X_REG_DIO_MAPPING_1, SX127X_DIO0_RX_DONE | SX127X_DIO1_RX_TIMEOUT, 7, 4);
+    if(_hopPeriod != SX127X_HOP_PERIOD_OFF) {
+      state |= _mod->SPIsetRegValue(SX127X_REG_DIO_MAPPING_1, SX127X_DIO0_RX_DONE | SX127X_DIO1_FHSS_CHANGE_CHANNEL, 7, 4);
+      writeFrf(_hopTable[0]);
+    } else {
+      state |= _mod->SPIsetRegValue(SX127X_REG_DIO_MAPPING_1, SX127X_DIO0_RX_DONE | SX127X_DIO1_RX_TIMEOUT, 7, 4);
+    }
 
     // set expected packet length for SF6
     if(_sf == 6) {
@@ -351,8 +809,9 @@ int16_t SX127x::startReceive(uint8_t len, uint8_t mode) {
     clearIRQFlags();
 
     // set FIFO pointers
-    state |= _mod->SPIsetRegValue(SX127X_REG_FIFO_RX_BASE_ADDR, SX127X_FIFO_RX_BASE_ADDR_MAX);
-    state |= _mod->SPIsetRegValue(SX127X_REG_FIFO_ADDR_PTR, SX127X_FIFO_RX_BASE_ADDR_MAX);
+    uint8_t rxBase = _fifoSplit ? SX127X_FIFO_RX_BASE_ADDR_SPLIT : SX127X_FIFO_RX_BASE_ADDR_MAX;
+    state |= _mod->SPIsetRegValue(SX127X_REG_FIFO_RX_BASE_ADDR, rxBase);
+    state |= _mod->SPIsetRegValue(SX127X_REG_FIFO_ADDR_PTR, rxBase);
     RADIOLIB_ASSERT(state);
 
   } else if(modem == SX127X_FSK_OOK) {
@@ -361,6 +820,7 @@ int16_t SX127x::startReceive(uint8_t len, uint8_t mode) {
 
     // clear interrupt flags
     clearIRQFlags();
+    _packetLengthQueried = false;
 
     // FSK modem does not distinguish between Rx single and continuous
     if(mode == SX127X_RXCONTINUOUS) {
@@ -381,55 +841,178 @@ void SX127x::clearDio0Action() {
 }
 
 void SX127x::setDio1Action(void (*func)(void)) {
-  if(_mod->getGpio() != RADIOLIB_NC) {
+  if(_mod->getGpio() == RADIOLIB_NC) {
     return;
   }
   attachInterrupt(digitalPinToInterrupt(_mod->getGpio()), func, RISING);
 }
 
 void SX127x::clearDio1Action() {
-  if(_mod->getGpio() != RADIOLIB_NC) {
+  if(_mod->getGpio() == RADIOLIB_NC) {
     return;
   }
   detachInterrupt(digitalPinToInterrupt(_mod->getGpio()));
 }
 
+void SX127x::setDio2Action(void (*func)(void)) {
+  if(_mod->getGpio2() == RADIOLIB_NC) {
+    return;
+  }
+  attachInterrupt(digitalPinToInterrupt(_mod->getGpio2()), func, RISING);
+}
+
+void SX127x::clearDio2Action() {
+  if(_mod->getGpio2() == RADIOLIB_NC) {
+    return;
+  }
+  detachInterrupt(digitalPinToInterrupt(_mod->getGpio2()));
+}
+
 int16_t SX127x::startTransmit(uint8_t* data, size_t len, uint8_t addr) {
+  // FSK packets that do not fit into FIFO are streamed, encrypted packets are rejected by length check instead
+  if((len >= SX127X_MAX_PACKET_LENGTH_FSK) && (getActiveModem() == SX127X_FSK_OOK) && (_cipher == NULL)) {
+    return(startTransmitStream(data, len, addr));
+  }
+
+  // upload packet and configuration
+  int16_t state = prepareTransmit(data, len, addr);
+  RADIOLIB_ASSERT(state);
+
+  // start transmission
+  return(setMode(SX127X_TX));
+}
+
+int16_t SX127x::scheduleTransmit(uint8_t* data, size_t len, uint32_t timestamp, uint8_t addr) {
+  // upload packet and configuration
+  int16_t state = prepareTransmit(data, len, addr);
+  RADIOLIB_ASSERT(state);
+
+  // start frequency synthesizer, so that only PA ramp-up remains at the deadline
+  state = setMode(SX127X_FSTX);
+  RADIOLIB_ASSERT(state);
+
+  // precompute final mode change
+  uint8_t opMode = (_mod->SPIreadRegister(SX127X_REG_OP_MODE) & 0b11111000) | SX127X_TX;
+
+  // check the deadline is still ahead
+  if((int32_t)(timestamp - Module::getMicros()) < 0) {
+    standby();
+    return(ERR_TX_DEADLINE_MISSED);
+  }
+
+  // wait for the deadline and start transmission
+  Module::waitUntil(timestamp);
+  uint32_t fired = Module::getMicros();
+  _mod->SPIwriteRegister(SX127X_REG_OP_MODE, opMode);
+
+  // record achieved timing
+  _scheduleJitter.add((int32_t)(fired - timestamp));
+
+  return(ERR_NONE);
+}
+
+int16_t SX127x::startTransmitLBT(uint8_t* data, size_t len) {
+  // check active modem
+  if(getActiveModem() != SX127X_LORA) {
+    return(ERR_WRONG_MODEM);
+  }
+
+  // upload packet and configuration
+  int16_t state = prepareTransmit(data, len, 0);
+  RADIOLIB_ASSERT(state);
+
+  // precompute register values, so that the loop below only needs raw writes
+  uint8_t dioMapping = _mod->SPIreadRegister(SX127X_REG_DIO_MAPPING_1) & 0b00001111;
+  uint8_t dioMappingCad = dioMapping | SX127X_DIO0_CAD_DONE | SX127X_DIO1_CAD_DETECTED;
+  uint8_t dioMappingTx = dioMapping | SX127X_DIO0_TX_DONE;
+  if(_hopPeriod != SX127X_HOP_PERIOD_OFF) {
+    dioMappingTx |= SX127X_DIO1_FHSS_CHANGE_CHANNEL;
+  }
+  uint8_t opMode = _mod->SPIreadRegister(SX127X_REG_OP_MODE) & 0b11111000;
+  _mod->SPIwriteRegister(SX127X_REG_DIO_MAPPING_1, dioMappingCad);
+
+  // single channel activity detection takes about 2 symbols
+  uint32_t symbolLength = ((uint32_t)1 << _sf) * 1000.0 / _bw;
+  uint32_t cadTimeout = 16 * symbolLength;
+  uint32_t slotLength = _lbtSlotLength ? _lbtSlotLength : symbolLength;
+
+  for(uint8_t attempt = 0; attempt < _lbtMaxAttempts; attempt++) {
+    // start channel activity detection
+    _mod->SPIwriteRegister(SX127X_REG_IRQ_FLAGS, 0b11111111);
+    _mod->SPIwriteRegister(SX127X_REG_OP_MODE, opMode | SX127X_CAD);
+
+    // wait for CAD done
+    uint8_t flags = waitForIrq(SX127X_CLEAR_IRQ_FLAG_CAD_DONE, cadTimeout);
+    if(!flags) {
+      clearIRQFlags();
+      standby();
+      return(ERR_UNKNOWN);
+    }
+
+    if(!(flags & SX127X_CLEAR_IRQ_FLAG_CAD_DETECTED)) {
+      // channel is free, module is in standby - start transmission right away
+      _mod->SPIwriteRegister(SX127X_REG_DIO_MAPPING_1, dioMappingTx);
+      _mod->SPIwriteRegister(SX127X_REG_IRQ_FLAGS, 0b11111111);
+      _mod->SPIwriteRegister(SX127X_REG_OP_MODE, opMode | SX127X_TX);
+      return(ERR_NONE);
+    }
+
+    // channel is busy, wait for random backoff
+    uint8_t exponent = attempt + 1;
+    if(exponent > _lbtMaxExponent) {
+      exponent = _lbtMaxExponent;
+    }
+    uint32_t slots = random32() & (((uint32_t)1 << exponent) - 1);
+    Module::waitUntil(Module::getMicros() + slots * slotLength);
+  }
+
+  // channel was busy on all attempts
+  clearIRQFlags();
+  _mod->SPIwriteRegister(SX127X_REG_DIO_MAPPING_1, dioMappingTx);
+  return(PREAMBLE_DETECTED);
+}
+
+int16_t SX127x::prepareTransmit(uint8_t* data, size_t len, uint8_t addr) {
   // set mode to standby
   int16_t state = setMode(SX127X_STANDBY);
 
   int16_t modem = getActiveModem();
   if(modem == SX127X_LORA) {
-    // check packet length
-    if(len >= SX127X_MAX_PACKET_LENGTH) {
+    // check packet length, payload cipher adds header and tag
+    size_t packetLen = len + getCipherOverhead();
+    if((packetLen >= SX127X_MAX_PACKET_LENGTH) || (_fifoSplit && (packetLen > SX127X_MAX_PACKET_LENGTH_SPLIT))) {
       return(ERR_PACKET_TOO_LONG);
     }
 
     // set DIO mapping
-    _mod->SPIsetRegValue(SX127X_REG_DIO_MAPPING_1, SX127X_DIO0_TX_DONE, 7, 6);
+    if(_hopPeriod != SX127X_HOP_PERIOD_OFF) {
+      _mod->SPIsetRegValue(SX127X_REG_DIO_MAPPING_1, SX127X_DIO0_TX_DONE | SX127X_DIO1_FHSS_CHANGE_CHANNEL, 7, 4);
+      writeFrf(_hopTable[0]);
+    } else {
+      _mod->SPIsetRegValue(SX127X_REG_DIO_MAPPING_1, SX127X_DIO0_TX_DONE, 7, 6);
+    }
 
     // clear interrupt flags
     clearIRQFlags();
 
     // set packet length
-    state |= _mod->SPIsetRegValue(SX127X_REG_PAYLOAD_LENGTH, len);
+    state |= _mod->SPIsetRegValue(SX127X_REG_PAYLOAD_LENGTH, packetLen);
 
     // set FIFO pointers
-    state |= _mod->SPIsetRegValue(SX127X_REG_FIFO_TX_BASE_ADDR, SX127X_FIFO_TX_BASE_ADDR_MAX);
-    state |= _mod->SPIsetRegValue(SX127X_REG_FIFO_ADDR_PTR, SX127X_FIFO_TX_BASE_ADDR_MAX);
+    uint8_t txBase = _fifoSplit ? SX127X_FIFO_TX_BASE_ADDR_SPLIT : SX127X_FIFO_TX_BASE_ADDR_MAX;
+    state |= _mod->SPIsetRegValue(SX127X_REG_FIFO_TX_BASE_ADDR, txBase);
+    state |= _mod->SPIsetRegValue(SX127X_REG_FIFO_ADDR_PTR, txBase);
 
-    // write packet to FIFO
-    _mod->SPIwriteRegisterBurst(SX127X_REG_FIFO, data, len);
+    // write packet to FIFO, this overwrites staged packet
+    writePayload(data, len);
+    _staged = false;
 
-    // start transmission
-    state |= setMode(SX127X_TX);
-    RADIOLIB_ASSERT(state);
-
-    return(ERR_NONE);
+    return(state);
 
   } else if(modem == SX127X_FSK_OOK) {
     // check packet length
-    if(len >= SX127X_MAX_PACKET_LENGTH_FSK) {
+    size_t packetLen = len + getCipherOverhead();
+    if(packetLen >= SX127X_MAX_PACKET_LENGTH_FSK) {
       return(ERR_PACKET_TOO_LONG);
     }
 
@@ -440,7 +1023,7 @@ int16_t SX127x::startTransmit(uint8_t* data, size_t len, uint8_t addr) {
     clearIRQFlags();
 
     // set packet length
-    _mod->SPIwriteRegister(SX127X_REG_FIFO, len);
+    _mod->SPIwriteRegister(SX127X_REG_FIFO, packetLen);
 
     // check address filtering
     uint8_t filter = _mod->SPIgetRegValue(SX127X_REG_PACKET_CONFIG_1, 2, 1);
@@ -449,13 +1032,9 @@ int16_t SX127x::startTransmit(uint8_t* data, size_t len, uint8_t addr) {
     }
 
     // write packet to FIFO
-    _mod->SPIwriteRegisterBurst(SX127X_REG_FIFO, data, len);
-
-    // start transmission
-    state |= setMode(SX127X_TX);
-    RADIOLIB_ASSERT(state);
+    writePayload(data, len);
 
-    return(ERR_NONE);
+    return(state);
   }
 
   return(ERR_UNKNOWN);
@@ -465,8 +1044,11 @@ int16_t SX127x::readData(uint8_t* data, size_t len) {
   int16_t modem = getActiveModem();
   size_t length = len;
 
-  // put module to standby
-  standby();
+  // put module to standby, unless FSK receiver restarts automatically and has to keep running
+  bool keepRunning = (modem == SX127X_FSK_OOK) && _autoRestartRx;
+  if(!keepRunning) {
+    standby();
+  }
 
   if(modem == SX127X_LORA) {
     // len set to maximum indicates unknown packet length, read the number of actually received bytes
@@ -482,9 +1064,15 @@ int16_t SX127x::readData(uint8_t* data, size_t len) {
       return(ERR_CRC_MISMATCH);
     }
 
+    // set FIFO pointer to the start of the last received packet
+    _mod->SPIwriteRegister(SX127X_REG_FIFO_ADDR_PTR, _mod->SPIreadRegister(SX127X_REG_FIFO_RX_CURRENT_ADDR));
+
   } else if(modem == SX127X_FSK_OOK) {
-    // read packet length (always required in FSK)
+    // read packet length (always required in FSK), bytes that do not fit into user buffer are dumped
     length = getPacketLength();
+    if(length > len) {
+      length = len;
+    }
 
     // check address filtering
     uint8_t filter = _mod->SPIgetRegValue(SX127X_REG_PACKET_CONFIG_1, 2, 1);
@@ -493,35 +1081,376 @@ int16_t SX127x::readData(uint8_t* data, size_t len) {
     }
   }
 
-  // read packet data
-  _mod->SPIreadRegisterBurst(SX127X_REG_FIFO, length, data);
+  // read packet data, decrypted in place when payload cipher is set, bytes that weren't requested are dumped
+  int16_t state = readPayload(data, length, getPacketLength());
+
+  // clear internal flag so getPacketLength can return the new packet length
+  _packetLengthQueried = false;
+
+  // clear interrupt flags - with automatic restart, flags are cleared by the module and clearing FIFO overrun flag would flush the next packet
+  if(!keepRunning) {
+    clearIRQFlags();
+  }
+
+  return(state);
+}
+
+int16_t SX127x::startTransmitStream(uint8_t* data, size_t len, uint8_t addr) {
+  // set up stream
+  int16_t state = startStream(data, len, true);
+  RADIOLIB_ASSERT(state);
+
+  // write header - length byte in variable length mode, followed by address when filtering is enabled
+  uint8_t space = SX127X_FIFO_SIZE;
+  if(len <= SX127X_MAX_PACKET_LENGTH) {
+    _mod->SPIwriteRegister(SX127X_REG_FIFO, len);
+    space--;
+  }
+  uint8_t filter = _mod->SPIgetRegValue(SX127X_REG_PACKET_CONFIG_1, 2, 1);
+  if((filter == SX127X_ADDRESS_FILTERING_NODE) || (filter == SX127X_ADDRESS_FILTERING_NODE_BROADCAST)) {
+    _mod->SPIwriteRegister(SX127X_REG_FIFO, addr);
+    space--;
+  }
+
+  // fill the FIFO
+  _streamPos = (len < space) ? len : space;
+  _mod->SPIwriteRegisterBurst(SX127X_REG_FIFO, data, _streamPos);
+
+  // start transmission
+  return(setMode(SX127X_TX));
+}
+
+int16_t SX127x::startReceiveStream(uint8_t* data, size_t len) {
+  // set up stream
+  int16_t state = startStream(data, len, false);
+  RADIOLIB_ASSERT(state);
+
+  // header - length byte in variable length mode, followed by address when filtering is enabled
+  if(len <= SX127X_MAX_PACKET_LENGTH) {
+    _streamHeader++;
+    _streamPacketLen = 0;
+  }
+  uint8_t filter = _mod->SPIgetRegValue(SX127X_REG_PACKET_CONFIG_1, 2, 1);
+  if((filter == SX127X_ADDRESS_FILTERING_NODE) || (filter == SX127X_ADDRESS_FILTERING_NODE_BROADCAST)) {
+    _streamHeader++;
+  }
+  _streamHeaderLen = _streamHeader;
+  _streamSync = false;
+
+  // set mode to receive
+  return(setMode(SX127X_RX));
+}
+
+bool SX127x::fifoService() {
+  if(!_streamActive) {
+    return(true);
+  }
+
+  uint8_t flags = _mod->SPIreadRegister(SX127X_REG_IRQ_FLAGS_2);
+  if(_streamTx) {
+    // check transmission end
+    if(flags & SX127X_FLAG_PACKET_SENT) {
+      finishStream();
+      return(true);
+    }
+
+    // FIFO level dropped to threshold, there is space for another chunk
+    if(!(flags & SX127X_FLAG_FIFO_LEVEL) && (_streamPos < _streamLen)) {
+      size_t chunk = _streamLen - _streamPos;
+      if(chunk > SX127X_FIFO_STREAM_CHUNK) {
+        chunk = SX127X_FIFO_STREAM_CHUNK;
+      }
+      _mod->SPIwriteRegisterBurst(SX127X_REG_FIFO, _streamData + _streamPos, chunk);
+      _streamPos += chunk;
+    }
+    return(false);
+  }
+
+  // SyncAddressMatch is set once per packet and cleared when FIFO is emptied, so it rises again only when the next packet is synchronized
+  // this happens when the FIFO was cleared without PayloadReady (e.g. CRC error), the packet has to be received from the start again
+  bool sync = _mod->SPIreadRegister(SX127X_REG_IRQ_FLAGS_1) & SX127X_FLAG_SYNC_ADDRESS_MATCH;
+  if(sync && !_streamSync) {
+    _streamHeader = _streamHeaderLen;
+    _streamPacketLen = (_streamLen <= SX127X_MAX_PACKET_LENGTH) ? 0 : _streamLen;
+    _streamPos = 0;
+  }
+  _streamSync = sync;
+
+  // read header as soon as it arrives
+  while((_streamHeader > 0) && !(flags & SX127X_FLAG_FIFO_EMPTY)) {
+    uint8_t b = _mod->SPIreadRegister(SX127X_REG_FIFO);
+    if(_streamPacketLen == 0) {
+      // variable length byte, address byte is dropped
+      _streamPacketLen = b;
+    }
+    _streamHeader--;
+    flags = _mod->SPIreadRegister(SX127X_REG_IRQ_FLAGS_2);
+  }
+  if(_streamHeader > 0) {
+    return(false);
+  }
+
+  // drain the rest of the packet, or one chunk when FIFO level exceeds threshold
+  size_t chunk = 0;
+  bool done = (flags & SX127X_FLAG_PAYLOAD_READY);
+  if(done) {
+    chunk = _streamPacketLen - _streamPos;
+  } else if(flags & SX127X_FLAG_FIFO_LEVEL) {
+    chunk = _streamPacketLen - _streamPos;
+    if(chunk > SX127X_FIFO_STREAM_CHUNK) {
+      chunk = SX127X_FIFO_STREAM_CHUNK;
+    }
+  }
+
+  if(chunk > 0) {
+    // bytes that do not fit into user buffer are dropped
+    size_t toBuffer = 0;
+    if(_streamPos < _streamLen) {
+      toBuffer = _streamLen - _streamPos;
+      if(toBuffer > chunk) {
+        toBuffer = chunk;
+      }
+      _mod->SPIreadRegisterBurst(SX127X_REG_FIFO, toBuffer, _streamData + _streamPos);
+    }
+    clearFIFO(chunk - toBuffer);
+    _streamPos += chunk;
+
+    // empty the FIFO so that SyncAddressMatch is cleared, otherwise the next packet could not be detected when this call comes from FIFO level interrupt
+    flags = _mod->SPIreadRegister(SX127X_REG_IRQ_FLAGS_2);
+    while(!done && !(flags & SX127X_FLAG_FIFO_EMPTY) && (_streamPos < _streamPacketLen)) {
+      uint8_t b = _mod->SPIreadRegister(SX127X_REG_FIFO);
+      if(_streamPos < _streamLen) {
+        _streamData[_streamPos] = b;
+      }
+      _streamPos++;
+      flags = _mod->SPIreadRegister(SX127X_REG_IRQ_FLAGS_2);
+    }
+    if(flags & SX127X_FLAG_FIFO_EMPTY) {
+      _streamSync = false;
+    }
+  }
+
+  if(done) {
+    // save packet length, it can no longer be read from FIFO
+    _packetLength = _streamPacketLen;
+    _packetLengthQueried = true;
+    finishStream();
+  }
+  return(done);
+}
+
+int16_t SX127x::stageTransmit(uint8_t* data, size_t len) {
+  // check active modem
+  if(getActiveModem() != SX127X_LORA) {
+    return(ERR_WRONG_MODEM);
+  }
+
+  // check FIFO mode
+  if(!_fifoSplit) {
+    return(ERR_FIFO_NOT_SPLIT);
+  }
+
+  // check packet length
+  size_t packetLen = len + getCipherOverhead();
+  if(packetLen > SX127X_MAX_PACKET_LENGTH_SPLIT) {
+    return(ERR_PACKET_TOO_LONG);
+  }
+
+  // continuous reception wraps through the whole FIFO and would overwrite the staged packet
+  uint8_t mode = _mod->SPIgetRegValue(SX127X_REG_OP_MODE, 2, 0);
+  if((mode != SX127X_STANDBY) && (mode != SX127X_RXSINGLE)) {
+    return(ERR_INVALID_MODE);
+  }
+
+  // previously staged packet is overwritten
+  _staged = false;
+
+  // FIFO can only be written in standby, single reception is restarted afterwards
+  int16_t state = setMode(SX127X_STANDBY);
+  RADIOLIB_ASSERT(state);
+
+  // write packet to TX half of FIFO
+  state = _mod->SPIsetRegValue(SX127X_REG_FIFO_ADDR_PTR, SX127X_FIFO_TX_BASE_ADDR_SPLIT);
+  RADIOLIB_ASSERT(state);
+  writePayload(data, len);
+
+  if(mode == SX127X_RXSINGLE) {
+    state = _mod->SPIsetRegValue(SX127X_REG_FIFO_ADDR_PTR, SX127X_FIFO_RX_BASE_ADDR_SPLIT);
+    state |= setMode(SX127X_RXSINGLE);
+    RADIOLIB_ASSERT(state);
+  }
+
+  // precompute register values, so that switching to transmit only takes a few raw writes
+  _stagedLength = packetLen;
+  _stagedDioMapping = (_mod->SPIreadRegister(SX127X_REG_DIO_MAPPING_1) & 0b00111111) | SX127X_DIO0_TX_DONE;
+  _stagedOpMode = (_mod->SPIreadRegister(SX127X_REG_OP_MODE) & 0b11111000) | SX127X_TX;
+  _staged = true;
+
+  return(ERR_NONE);
+}
+
+int16_t SX127x::startTransmitStaged() {
+  // check active modem
+  if(getActiveModem() != SX127X_LORA) {
+    return(ERR_WRONG_MODEM);
+  }
+
+  // check FIFO mode
+  if(!_fifoSplit) {
+    return(ERR_FIFO_NOT_SPLIT);
+  }
+
+  // check there is a packet to transmit, each staged packet is only transmitted once
+  if(!_staged) {
+    return(ERR_NOTHING_STAGED);
+  }
+  _staged = false;
+
+  // set DIO mapping
+  _mod->SPIwriteRegister(SX127X_REG_DIO_MAPPING_1, _stagedDioMapping);
+
+  // clear interrupt flags
+  _mod->SPIwriteRegister(SX127X_REG_IRQ_FLAGS, 0b11111111);
+
+  // set packet length
+  _mod->SPIwriteRegister(SX127X_REG_PAYLOAD_LENGTH, _stagedLength);
+
+  // start transmission
+  _mod->SPIwriteRegister(SX127X_REG_OP_MODE, _stagedOpMode);
+
+  return(ERR_NONE);
+}
+
+int16_t SX127x::setSyncWord(uint8_t syncWord) {
+  // check active modem
+  if(getActiveModem() != SX127X_LORA) {
+    return(ERR_WRONG_MODEM);
+  }
+
+  // set mode to standby
+  setMode(SX127X_STANDBY);
+
+  // write register
+  return(_mod->SPIsetRegValue(SX127X_REG_SYNC_WORD, syncWord));
+}
+
+int16_t SX127x::setSymbolTimeout(uint16_t symbols) {
+  // check active modem
+  if(getActiveModem() != SX127X_LORA) {
+    return(ERR_WRONG_MODEM);
+  }
+
+  RADIOLIB_CHECK_RANGE(symbols, 4, 1023, ERR_INVALID_SYMBOL_TIMEOUT);
+
+  // set mode to standby
+  int16_t state = setMode(SX127X_STANDBY);
+
+  // write registers, timeout is split between MODEM_CONFIG_2 bits 1:0 and SYMB_TIMEOUT_LSB
+  state |= _mod->SPIsetRegValue(SX127X_REG_MODEM_CONFIG_2, (uint8_t)(symbols >> 8), 1, 0);
+  state |= _mod->SPIsetRegValue(SX127X_REG_SYMB_TIMEOUT_LSB, (uint8_t)(symbols & 0xFF));
+  return(state);
+}
+
+int16_t SX127x::setFrequencyHopping(uint8_t hopPeriod, const uint32_t* frfTable, uint8_t numChannels) {
+  // check active modem
+  if(getActiveModem() != SX127X_LORA) {
+    return(ERR_WRONG_MODEM);
+  }
+
+  // check hop table
+  if((hopPeriod != SX127X_HOP_PERIOD_OFF) && ((frfTable == NULL) || (numChannels == 0))) {
+    return(ERR_INVALID_FREQUENCY);
+  }
+
+  // set mode to standby
+  int16_t state = setMode(SX127X_STANDBY);
+  RADIOLIB_ASSERT(state);
+
+  // set hop period
+  state = _mod->SPIsetRegValue(SX127X_REG_HOP_PERIOD, hopPeriod);
+  RADIOLIB_ASSERT(state);
+
+  if(hopPeriod == SX127X_HOP_PERIOD_OFF) {
+    // return to the configured frequency
+    _hopPeriod = SX127X_HOP_PERIOD_OFF;
+    _hopTable = NULL;
+    _hopChannels = 0;
+    return(setFrequencyRaw(_freq));
+  }
+
+  // save hop table
+  _hopPeriod = hopPeriod;
+  _hopTable = frfTable;
+  _hopChannels = numChannels;
+  return(state);
+}
+
+void SX127x::setListenBeforeTalk(uint8_t maxAttempts, uint32_t slotLength, uint8_t maxExponent) {
+  // at least one channel activity detection is needed to find out whether the channel is free
+  _lbtMaxAttempts = (maxAttempts < 1) ? 1 : maxAttempts;
+  _lbtSlotLength = slotLength;
+  _lbtMaxExponent = maxExponent;
+  if(_lbtMaxExponent < 1) {
+    _lbtMaxExponent = 1;
+  } else if(_lbtMaxExponent > 15) {
+    _lbtMaxExponent = 15;
+  }
+}
+
+int16_t SX127x::setRxTimeout(uint32_t rssiTimeout, uint32_t preambleTimeout, uint32_t syncTimeout) {
+  // check active modem
+  if(getActiveModem() != SX127X_FSK_OOK) {
+    return(ERR_WRONG_MODEM);
+  }
 
-  // dump bytes that weren't requested
-  size_t packetLength = getPacketLength();
-  if(packetLength > length) {
-    clearFIFO(packetLength - length);
+  // convert to units of 16 bit periods
+  uint32_t timeouts[3] = { rssiTimeout, preambleTimeout, syncTimeout };
+  uint8_t raw[3];
+  for(uint8_t i = 0; i < 3; i++) {
+    uint32_t units = ceil((float)timeouts[i] * _br / 16000.0);
+    if(units > 0xFF) {
+      return(ERR_INVALID_RX_TIMEOUT);
+    }
+    raw[i] = units;
   }
 
-  // clear internal flag so getPacketLength can return the new packet length
-  _packetLengthQueried = false;
+  // set mode to standby
+  int16_t state = setMode(SX127X_STANDBY);
+  RADIOLIB_ASSERT(state);
 
-  // clear interrupt flags
-  clearIRQFlags();
+  // write registers
+  state = _mod->SPIsetRegValue(SX127X_REG_RX_TIMEOUT_1, raw[0]);
+  state |= _mod->SPIsetRegValue(SX127X_REG_RX_TIMEOUT_2, raw[1]);
+  state |= _mod->SPIsetRegValue(SX127X_REG_RX_TIMEOUT_3, raw[2]);
 
-  return(ERR_NONE);
+  // signal timeout on DIO2
+  state |= _mod->SPIsetRegValue(SX127X_REG_DIO_MAPPING_1, SX127X_DIO2_PACK_TIMEOUT, 3, 2);
+  RADIOLIB_ASSERT(state);
+
+  _rxTimeoutConfigured = (raw[0] != 0) || (raw[1] != 0) || (raw[2] != 0);
+  return(state);
 }
 
-int16_t SX127x::setSyncWord(uint8_t syncWord) {
+int16_t SX127x::setAutoRestartRx(bool enable, bool waitForPllLock) {
   // check active modem
-  if(getActiveModem() != SX127X_LORA) {
+  if(getActiveModem() != SX127X_FSK_OOK) {
     return(ERR_WRONG_MODEM);
   }
 
   // set mode to standby
-  setMode(SX127X_STANDBY);
+  int16_t state = setMode(SX127X_STANDBY);
+  RADIOLIB_ASSERT(state);
 
-  // write register
-  return(_mod->SPIsetRegValue(SX127X_REG_SYNC_WORD, syncWord));
+  // set restart mode
+  uint8_t mode = SX127X_AUTO_RESTART_RX_MODE_OFF;
+  if(enable) {
+    mode = waitForPllLock ? SX127X_AUTO_RESTART_RX_MODE_PLL : SX127X_AUTO_RESTART_RX_MODE_NO_PLL;
+  }
+  state = _mod->SPIsetRegValue(SX127X_REG_SYNC_CONFIG, mode, 7, 6);
+  RADIOLIB_ASSERT(state);
+
+  _autoRestartRx = enable;
+  return(state);
 }
 
 int16_t SX127x::setCurrentLimit(uint8_t currentLimit) {
@@ -564,12 +1493,18 @@ int16_t SX127x::setPreambleLength(uint16_t preambleLength) {
     // set preamble length
     state = _mod->SPIsetRegValue(SX127X_REG_PREAMBLE_MSB, (uint8_t)((preambleLength >> 8) & 0xFF));
     state |= _mod->SPIsetRegValue(SX127X_REG_PREAMBLE_LSB, (uint8_t)(preambleLength & 0xFF));
+    if(state == ERR_NONE) {
+      _preambleLength = preambleLength;
+    }
     return(state);
 
   } else if(modem == SX127X_FSK_OOK) {
     // set preamble length
     state = _mod->SPIsetRegValue(SX127X_REG_PREAMBLE_MSB_FSK, (uint8_t)((preambleLength >> 8) & 0xFF));
     state |= _mod->SPIsetRegValue(SX127X_REG_PREAMBLE_LSB_FSK, (uint8_t)(preambleLength & 0xFF));
+    if(state == ERR_NONE) {
+      _preambleLength = preambleLength;
+    }
     return(state);
   }
 
@@ -821,31 +1756,112 @@ int16_t SX127x::setOOK(bool enableOOK) {
   return(state);
 }
 
+int16_t SX127x::setFifoSplit(bool enableSplit) {
+  // check active modem
+  if(getActiveModem() != SX127X_LORA) {
+    return(ERR_WRONG_MODEM);
+  }
+
+  // set mode to standby
+  int16_t state = setMode(SX127X_STANDBY);
+  RADIOLIB_ASSERT(state);
+
+  // staged packet is lost when FIFO layout changes
+  _staged = false;
+
+  // set FIFO base addresses and limit received packet length, so that received data can't overflow into TX half
+  if(enableSplit) {
+    state = _mod->SPIsetRegValue(SX127X_REG_FIFO_TX_BASE_ADDR, SX127X_FIFO_TX_BASE_ADDR_SPLIT);
+    state |= _mod->SPIsetRegValue(SX127X_REG_FIFO_RX_BASE_ADDR, SX127X_FIFO_RX_BASE_ADDR_SPLIT);
+    state |= _mod->SPIsetRegValue(SX127X_REG_MAX_PAYLOAD_LENGTH, SX127X_MAX_PAYLOAD_LENGTH_SPLIT);
+  } else {
+    state = _mod->SPIsetRegValue(SX127X_REG_FIFO_TX_BASE_ADDR, SX127X_FIFO_TX_BASE_ADDR_MAX);
+    state |= _mod->SPIsetRegValue(SX127X_REG_FIFO_RX_BASE_ADDR, SX127X_FIFO_RX_BASE_ADDR_MAX);
+    state |= _mod->SPIsetRegValue(SX127X_REG_MAX_PAYLOAD_LENGTH, SX127X_MAX_PAYLOAD_LENGTH_FULL);
+  }
+
+  // save the new setting
+  if(state == ERR_NONE) {
+    _fifoSplit = enableSplit;
+  }
+  return(state);
+}
+
+void SX127x::setPayloadCipher(PayloadCipher* cipher) {
+  _cipher = cipher;
+}
+
+Module* SX127x::getMod() {
+  return(_mod);
+}
+
 int16_t SX127x::setFrequencyRaw(float newFreq) {
   // set mode to standby
   int16_t state = setMode(SX127X_STANDBY);
 
   // calculate register values
-  uint32_t FRF = (newFreq * (uint32_t(1) << SX127X_DIV_EXPONENT)) / SX127X_CRYSTAL_FREQ;
+  uint32_t FRF = calculateFrf(newFreq);
 
   // write registers
-  state |= _mod->SPIsetRegValue(SX127X_REG_FRF_MSB, (FRF & 0xFF0000) >> 16);
-  state |= _mod->SPIsetRegValue(SX127X_REG_FRF_MID, (FRF & 0x00FF00) >> 8);
-  state |= _mod->SPIsetRegValue(SX127X_REG_FRF_LSB, FRF & 0x0000FF);
+  writeFrf(FRF);
+
+  // check all three registers were written
+  uint8_t frf[3];
+  _mod->SPIreadRegisterBurst(SX127X_REG_FRF_MSB, 3, frf);
+  if((((uint32_t)frf[0] << 16) | ((uint32_t)frf[1] << 8) | (uint32_t)frf[2]) != FRF) {
+    return(ERR_SPI_WRITE_FAILED);
+  }
   return(state);
 }
 
+uint32_t SX127x::calculateFrf(float freq) {
+  return(calculateFrfHz((uint32_t)(freq * 1000000.0 + 0.5)));
+}
+
+uint32_t SX127x::calculateFrfHz(uint32_t freq) {
+  // FRF = freq * 2^19 / 32 MHz = freq * 256 / 15625
+  // split to quotient and remainder so that the intermediate result fits into 32 bits
+  uint32_t q = freq / 15625;
+  uint32_t r = freq % 15625;
+  return((q << 8) + ((r << 8) + 15625/2) / 15625);
+}
+
+int16_t SX127x::retune(const SX127xChannelTable& table, uint8_t channel) {
+  if(channel >= table.getNumChannels()) {
+    return(ERR_INVALID_FREQUENCY);
+  }
+
+  _mod->SPIwriteRegisterBurst(SX127X_REG_FRF_MSB, (uint8_t*)table.getFrfBytes(channel), 3);
+  return(ERR_NONE);
+}
+
+int16_t SX127x::fhssChangeChannel() {
+  // check frequency hopping is enabled
+  if((_hopPeriod == SX127X_HOP_PERIOD_OFF) || (_hopChannels == 0)) {
+    return(ERR_UNKNOWN);
+  }
+
+  // write frequency of the channel the module just switched to
+  uint8_t channel = _mod->SPIreadRegister(SX127X_REG_HOP_CHANNEL) & SX127X_HOP_CHANNEL_PRESENT;
+  writeFrf(_hopTable[channel % _hopChannels]);
+
+  // clear interrupt flag
+  _mod->SPIwriteRegister(SX127X_REG_IRQ_FLAGS, SX127X_CLEAR_IRQ_FLAG_FHSS_CHANGE_CHANNEL);
+  return(ERR_NONE);
+}
+
 size_t SX127x::getPacketLength(bool update) {
   int16_t modem = getActiveModem();
+  size_t length = _packetLength;
 
   if(modem == SX127X_LORA) {
     if(_sf != 6) {
       // get packet length for SF7 - SF12
-      return(_mod->SPIreadRegister(SX127X_REG_RX_NB_BYTES));
+      length = _mod->SPIreadRegister(SX127X_REG_RX_NB_BYTES);
 
     } else {
       // return the maximum value for SF6
-      return(SX127X_MAX_PACKET_LENGTH);
+      length = SX127X_MAX_PACKET_LENGTH;
     }
 
   } else if(modem == SX127X_FSK_OOK) {
@@ -854,9 +1870,12 @@ size_t SX127x::getPacketLength(bool update) {
       _packetLength = _mod->SPIreadRegister(SX127X_REG_FIFO);
       _packetLengthQueried = true;
     }
+    length = _packetLength;
   }
 
-  return(_packetLength);
+  // payload cipher header and tag are not part of the payload
+  uint8_t overhead = getCipherOverhead();
+  return((length > overhead) ? length - overhead : 0);
 }
 
 int16_t SX127x::fixedPacketLengthMode(uint8_t len) {
@@ -887,9 +1906,49 @@ int16_t SX127x::setRSSIConfig(uint8_t smoothingSamples, int8_t offset) {
   // set new register values
   state = _mod->SPIsetRegValue(SX127X_REG_RSSI_CONFIG, offset, 7, 3);
   state |= _mod->SPIsetRegValue(SX127X_REG_RSSI_CONFIG, smoothingSamples, 2, 0);
+  _rssiSmoothing = smoothingSamples;
   return(state);
 }
 
+int16_t SX127x::applyProfile(const SX127xProfile& profile) {
+  // check active modem
+  if(getActiveModem() != SX127X_LORA) {
+    return(ERR_WRONG_MODEM);
+  }
+
+  // set mode to standby
+  int16_t state = setMode(SX127X_STANDBY);
+  RADIOLIB_ASSERT(state);
+
+  // write precomputed registers, MODEM_CONFIG_1 and MODEM_CONFIG_2 are adjacent
+  _mod->SPIwriteRegisterBurst(SX127X_REG_MODEM_CONFIG_1, (uint8_t*)profile.regs, 2);
+  if(profile.modemConfig3Addr != 0) {
+    _mod->SPIwriteRegister(profile.modemConfig3Addr, profile.regs[2]);
+  }
+  _mod->SPIwriteRegister(SX127X_REG_DETECT_OPTIMIZE, profile.regs[3]);
+  _mod->SPIwriteRegister(SX127X_REG_DETECTION_THRESHOLD, profile.regs[4]);
+  _mod->SPIwriteRegister(SX127X_REG_PA_CONFIG, profile.regs[5]);
+  _mod->SPIwriteRegister(profile.paDacAddr, profile.regs[6]);
+
+  // save the new settings
+  _sf = profile.sf;
+  _bw = profile.bw;
+  _cr = profile.cr;
+  return(ERR_NONE);
+}
+
+int16_t SX127x::setRSSIThreshold(float rssi) {
+  // check active modem
+  if(getActiveModem() != SX127X_FSK_OOK) {
+    return(ERR_WRONG_MODEM);
+  }
+
+  RADIOLIB_CHECK_RANGE(rssi, -127.5, 0.0, ERR_INVALID_RSSI_THRESHOLD);
+
+  // threshold is in -0.5 dB steps
+  return(_mod->SPIsetRegValue(SX127X_REG_RSSI_THRESH, (uint8_t)(rssi * -2.0)));
+}
+
 int16_t SX127x::setEncoding(uint8_t encoding) {
   // check active modem
   if(getActiveModem() != SX127X_FSK_OOK) {
@@ -912,6 +1971,7 @@ int16_t SX127x::setEncoding(uint8_t encoding) {
 int16_t SX127x::config() {
   // turn off frequency hopping
   int16_t state = _mod->SPIsetRegValue(SX127X_REG_HOP_PERIOD, SX127X_HOP_PERIOD_OFF);
+  _hopPeriod = SX127X_HOP_PERIOD_OFF;
   return(state);
 }
 
@@ -932,6 +1992,11 @@ int16_t SX127x::configFSK() {
   state =_mod->SPIsetRegValue(SX127X_REG_SYNC_CONFIG, SX127X_PREAMBLE_POLARITY_55, 5, 5);
   RADIOLIB_ASSERT(state);
 
+  // disable automatic receiver restart
+  state = _mod->SPIsetRegValue(SX127X_REG_SYNC_CONFIG, SX127X_AUTO_RESTART_RX_MODE_OFF, 7, 6);
+  RADIOLIB_ASSERT(state);
+  _autoRestartRx = false;
+
   // set FIFO threshold
   state = _mod->SPIsetRegValue(SX127X_REG_FIFO_THRESH, SX127X_TX_START_FIFO_NOT_EMPTY, 7, 7);
   state |= _mod->SPIsetRegValue(SX127X_REG_FIFO_THRESH, SX127X_FIFO_THRESH, 5, 0);
@@ -942,6 +2007,7 @@ int16_t SX127x::configFSK() {
   state |= _mod->SPIsetRegValue(SX127X_REG_RX_TIMEOUT_2, SX127X_TIMEOUT_RX_PREAMBLE_OFF);
   state |= _mod->SPIsetRegValue(SX127X_REG_RX_TIMEOUT_3, SX127X_TIMEOUT_SIGNAL_SYNC_OFF);
   RADIOLIB_ASSERT(state);
+  _rxTimeoutConfigured = false;
 
   // enable preamble detector and set preamble length
   state = _mod->SPIsetRegValue(SX127X_REG_PREAMBLE_DETECT, SX127X_PREAMBLE_DETECTOR_ON | SX127X_PREAMBLE_DETECTOR_2_BYTE | SX127X_PREAMBLE_DETECTOR_TOL);
@@ -952,11 +2018,6 @@ int16_t SX127x::configFSK() {
 }
 
 int16_t SX127x::setPacketMode(uint8_t mode, uint8_t len) {
-  // check packet length
-  if (len > SX127X_MAX_PACKET_LENGTH_FSK) {
-    return(ERR_PACKET_TOO_LONG);
-  }
-
   // check active modem
   if(getActiveModem() != SX127X_FSK_OOK) {
     return(ERR_WRONG_MODEM);
@@ -1010,6 +2071,54 @@ int16_t SX127x::setMode(uint8_t mode) {
   return(_mod->SPIsetRegValue(SX127X_REG_OP_MODE, mode, 2, 0, 5));
 }
 
+uint32_t SX127x::getTimeOnAir(size_t len) {
+  // payload cipher header and tag
+  len += getCipherOverhead();
+
+  if(getActiveModem() == SX127X_FSK_OOK) {
+    // preamble and sync word
+    uint32_t n_bytes = (_mod->SPIgetRegValue(SX127X_REG_PREAMBLE_MSB_FSK) << 8) | _mod->SPIgetRegValue(SX127X_REG_PREAMBLE_LSB_FSK);
+    uint8_t syncConfig = _mod->SPIgetRegValue(SX127X_REG_SYNC_CONFIG);
+    if(syncConfig & SX127X_SYNC_ON) {
+      n_bytes += (syncConfig & SX127X_SYNC_SIZE) + 1;
+    }
+
+    // length byte, address and CRC
+    uint8_t packetConfig = _mod->SPIgetRegValue(SX127X_REG_PACKET_CONFIG_1);
+    if(packetConfig & SX127X_PACKET_VARIABLE) {
+      n_bytes++;
+    }
+    if(packetConfig & (SX127X_ADDRESS_FILTERING_NODE | SX127X_ADDRESS_FILTERING_NODE_BROADCAST)) {
+      n_bytes++;
+    }
+    if(packetConfig & SX127X_CRC_ON) {
+      n_bytes += 2;
+    }
+
+    // bit rate is in kbps
+    n_bytes += len;
+    return(ceil(((float)n_bytes * 8.0 * 1000.0) / _br));
+  }
+
+  // calculate expected time-on-air in microseconds
+  float symbolLength = (float)(uint32_t(1) <<_sf) / (float)_bw;
+  float de = 0;
+  if(symbolLength >= 16.0) {
+    de = 1;
+  }
+  float ih = (float)_mod->SPIgetRegValue(SX127X_REG_MODEM_CONFIG_1, 0, 0);
+  float crc = (float)(_mod->SPIgetRegValue(SX127X_REG_MODEM_CONFIG_2, 2, 2) >> 2);
+  float n_pre = (float)((_mod->SPIgetRegValue(SX127X_REG_PREAMBLE_MSB) << 8) | _mod->SPIgetRegValue(SX127X_REG_PREAMBLE_LSB));
+  float n_pay = 8.0 + max(ceil((8.0 * (float)len - 4.0 * (float)_sf + 28.0 + 16.0 * crc - 20.0 * ih)/(4.0 * (float)_sf - 8.0 * de)) * (float)_cr, 0.0);
+  return(ceil(symbolLength * (n_pre + n_pay + 4.25) * 1000.0));
+}
+
+int16_t SX127x::checkSpreadingFactor(uint8_t sf) {
+  // spreading factors supported by all modules, derived classes with narrower range override this
+  RADIOLIB_CHECK_RANGE(sf, 6, 12, ERR_INVALID_SPREADING_FACTOR);
+  return(ERR_NONE);
+}
+
 int16_t SX127x::getActiveModem() {
   return(_mod->SPIgetRegValue(SX127X_REG_OP_MODE, 7, 7));
 }
@@ -1026,6 +2135,232 @@ int16_t SX127x::setActiveModem(uint8_t modem) {
   return(state);
 }
 
+uint8_t SX127x::waitForIrq(uint8_t mask, uint32_t timeout) {
+  // DIO pins are checked first to avoid SPI traffic, IRQ flags are polled directly when a pin is not connected
+  bool poll = (_mod->getIrq() == RADIOLIB_NC) || (_mod->getGpio() == RADIOLIB_NC);
+  uint32_t start = Module::getMicros();
+  while(Module::getMicros() - start <= timeout) {
+    if(poll || Module::digitalRead(_mod->getIrq()) || Module::digitalRead(_mod->getGpio())) {
+      uint8_t flags = _mod->SPIreadRegister(SX127X_REG_IRQ_FLAGS);
+      if(flags & mask) {
+        return(flags);
+      }
+    }
+  }
+  return(0);
+}
+
+int16_t SX127x::setSequencerTimer(uint8_t timer, uint32_t period) {
+  // find the finest resolution that fits, resolutions are 64 us, 4.1 ms and 262 ms
+  uint8_t resolution = 1;
+  uint32_t step = 64;
+  while((period > step * 255) && (resolution < 3)) {
+    resolution++;
+    step *= 64;
+  }
+
+  uint32_t coef = (period + step/2) / step;
+  if(coef < 1) {
+    coef = 1;
+  } else if(coef > 255) {
+    coef = 255;
+  }
+
+  // timer 1 resolution is in bits 3:2, timer 2 in bits 1:0
+  if(timer == 1) {
+    int16_t state = _mod->SPIsetRegValue(SX127X_REG_TIMER_RESOL, resolution << 2, 3, 2);
+    state |= _mod->SPIsetRegValue(SX127X_REG_TIMER1_COEF, (uint8_t)coef);
+    return(state);
+  }
+  int16_t state = _mod->SPIsetRegValue(SX127X_REG_TIMER_RESOL, resolution, 1, 0);
+  state |= _mod->SPIsetRegValue(SX127X_REG_TIMER2_COEF, (uint8_t)coef);
+  return(state);
+}
+
+int16_t SX127x::startStream(uint8_t* data, size_t len, bool tx) {
+  // check active modem
+  if(getActiveModem() != SX127X_FSK_OOK) {
+    return(ERR_WRONG_MODEM);
+  }
+
+  // check packet length, payload cipher only supports packets that fit into FIFO
+  if((len > SX127X_MAX_PACKET_LENGTH_STREAM) || (_cipher != NULL)) {
+    return(ERR_PACKET_TOO_LONG);
+  }
+
+  // set mode to standby
+  int16_t state = setMode(SX127X_STANDBY);
+  RADIOLIB_ASSERT(state);
+
+  // save packet configuration
+  _streamConfig[0] = _mod->SPIreadRegister(SX127X_REG_PACKET_CONFIG_1);
+  _streamConfig[1] = _mod->SPIreadRegister(SX127X_REG_PACKET_CONFIG_2);
+  _streamConfig[2] = _mod->SPIreadRegister(SX127X_REG_PAYLOAD_LENGTH_FSK);
+  _streamConfig[3] = _mod->SPIreadRegister(SX127X_REG_FIFO_THRESH);
+
+  // variable length mode up to 255 bytes, fixed length mode with 11-bit length above that
+  if(len <= SX127X_MAX_PACKET_LENGTH) {
+    state = _mod->SPIsetRegValue(SX127X_REG_PACKET_CONFIG_1, SX127X_PACKET_VARIABLE, 7, 7);
+    state |= _mod->SPIsetRegValue(SX127X_REG_PACKET_CONFIG_2, 0, 2, 0);
+    state |= _mod->SPIsetRegValue(SX127X_REG_PAYLOAD_LENGTH_FSK, tx ? len : SX127X_MAX_PACKET_LENGTH);
+  } else {
+    state = _mod->SPIsetRegValue(SX127X_REG_PACKET_CONFIG_1, SX127X_PACKET_FIXED, 7, 7);
+    state |= _mod->SPIsetRegValue(SX127X_REG_PACKET_CONFIG_2, (len >> 8) & 0x07, 2, 0);
+    state |= _mod->SPIsetRegValue(SX127X_REG_PAYLOAD_LENGTH_FSK, len & 0xFF);
+  }
+  state |= _mod->SPIsetRegValue(SX127X_REG_FIFO_THRESH, SX127X_TX_START_FIFO_NOT_EMPTY | SX127X_FIFO_STREAM_THRESHOLD);
+
+  // set DIO mapping
+  if(tx) {
+    state |= _mod->SPIsetRegValue(SX127X_REG_DIO_MAPPING_1, SX127X_DIO0_PACK_PACKET_SENT | SX127X_DIO1_PACK_FIFO_LEVEL, 7, 4);
+  } else {
+    state |= _mod->SPIsetRegValue(SX127X_REG_DIO_MAPPING_1, SX127X_DIO0_PACK_PAYLOAD_READY | SX127X_DIO1_PACK_FIFO_LEVEL, 7, 4);
+  }
+  RADIOLIB_ASSERT(state);
+
+  // clear interrupt flags (also clears FIFO)
+  clearIRQFlags();
+
+  // save stream state
+  _streamData = data;
+  _streamLen = len;
+  _streamPacketLen = len;
+  _streamPos = 0;
+  _streamHeader = 0;
+  _streamTx = tx;
+  _streamActive = true;
+  return(ERR_NONE);
+}
+
+void SX127x::finishStream() {
+  if(!_streamActive) {
+    return;
+  }
+  _streamActive = false;
+
+  // restore packet configuration, raw writes are used as this may be called from interrupt context
+  _mod->SPIwriteRegister(SX127X_REG_OP_MODE, (_mod->SPIreadRegister(SX127X_REG_OP_MODE) & 0b11111000) | SX127X_STANDBY);
+  _mod->SPIwriteRegister(SX127X_REG_PACKET_CONFIG_1, _streamConfig[0]);
+  _mod->SPIwriteRegister(SX127X_REG_PACKET_CONFIG_2, _streamConfig[1]);
+  _mod->SPIwriteRegister(SX127X_REG_PAYLOAD_LENGTH_FSK, _streamConfig[2]);
+  _mod->SPIwriteRegister(SX127X_REG_FIFO_THRESH, _streamConfig[3]);
+}
+
+void SX127x::writeFrf(uint32_t FRF) {
+  // new frequency is applied once LSB is written, so all three bytes are written in a single burst
+  uint8_t frf[3] = { (uint8_t)((FRF >> 16) & 0xFF), (uint8_t)((FRF >> 8) & 0xFF), (uint8_t)(FRF & 0xFF) };
+  _mod->SPIwriteRegisterBurst(SX127X_REG_FRF_MSB, frf, 3);
+}
+
+int16_t SX127x::receiveFSK(uint8_t* data, size_t len, uint32_t timeout) {
+  // set mode to standby
+  int16_t state = setMode(SX127X_STANDBY);
+  RADIOLIB_ASSERT(state);
+
+  // use hardware sync address timeout, unless timeouts were configured by setRxTimeout
+  // timeout is in units of 16 bit periods, longer timeouts are left to software
+  if(!_rxTimeoutConfigured) {
+    uint32_t syncTimeout = ceil((float)timeout * _br / 16000.0);
+    if(syncTimeout > 0xFF) {
+      syncTimeout = SX127X_TIMEOUT_SIGNAL_SYNC_OFF;
+    }
+    state = _mod->SPIsetRegValue(SX127X_REG_RX_TIMEOUT_3, syncTimeout);
+    RADIOLIB_ASSERT(state);
+  }
+
+  // signal timeout on DIO2
+  state = _mod->SPIsetRegValue(SX127X_REG_DIO_MAPPING_1, SX127X_DIO2_PACK_TIMEOUT, 3, 2);
+  RADIOLIB_ASSERT(state);
+
+  // software timeout only catches packets that started but never finished (e.g. CRC error), so it includes the packet itself
+  timeout += (uint32_t)((float)(len * 8) * 1000.0 / _br);
+
+  // packets that do not fit into FIFO are streamed, encrypted packets always fit into FIFO
+  uint32_t start = Module::getMicros();
+  if((len > SX127X_MAX_PACKET_LENGTH_FSK) && (_cipher == NULL)) {
+    state = startReceiveStream(data, len);
+
+    // drain FIFO until the whole packet was received or timeout occurred
+    while((state == ERR_NONE) && !fifoService()) {
+      yield();
+      if(rxTimeoutFSK() || (Module::getMicros() - start > timeout)) {
+        finishStream();
+        clearIRQFlags();
+        state = ERR_RX_TIMEOUT;
+      }
+    }
+
+  } else {
+    // set mode to receive
+    state = startReceive(len, SX127X_RX);
+
+    // wait for packet reception or timeout
+    while((state == ERR_NONE) && !Module::digitalRead(_mod->getIrq())) {
+      yield();
+      if(rxTimeoutFSK() || (Module::getMicros() - start > timeout)) {
+        clearIRQFlags();
+        standby();
+        state = ERR_RX_TIMEOUT;
+      }
+    }
+
+    // read the received data
+    if(state == ERR_NONE) {
+      state = readData(data, len);
+    }
+
+    // automatically restarted receiver is still running
+    if(_autoRestartRx) {
+      standby();
+    }
+  }
+
+  // disable the timeout again, so that it does not affect interrupt-driven reception
+  if(!_rxTimeoutConfigured) {
+    _mod->SPIwriteRegister(SX127X_REG_RX_TIMEOUT_3, SX127X_TIMEOUT_SIGNAL_SYNC_OFF);
+  }
+  return(state);
+}
+
+bool SX127x::rxTimeoutFSK() {
+  // Timeout is mapped to DIO2, IRQ flags only have to be read when DIO2 is not connected
+  if(_mod->getGpio2() != RADIOLIB_NC) {
+    return(Module::digitalRead(_mod->getGpio2()));
+  }
+  return(_mod->SPIreadRegister(SX127X_REG_IRQ_FLAGS_1) & SX127X_FLAG_TIMEOUT);
+}
+
+uint32_t SX127x::random32() {
+  // seed from RSSI noise and current time on first use
+  if(_lbtSeed == 0) {
+    // RSSI is only updated while receiving, so switch to receive mode and restore the previous mode afterwards
+    uint8_t prevMode = _mod->SPIgetRegValue(SX127X_REG_OP_MODE, 2, 0);
+    setMode(SX127X_RX);
+    uint8_t reg = (getActiveModem() == SX127X_LORA) ? SX127X_REG_RSSI_WIDEBAND : SX127X_REG_RSSI_VALUE_FSK;
+
+    // only the least significant bit is random enough, sample timing adds more entropy
+    uint32_t start = Module::getMicros();
+    Module::waitUntil(start + SX127X_RANDOM_SETTLE_TIME);
+    for(uint8_t i = 0; i < 32; i++) {
+      _lbtSeed = (_lbtSeed << 1) | (_mod->SPIreadRegister(reg) & 0x01);
+      Module::waitUntil(Module::getMicros() + SX127X_RANDOM_SAMPLE_PERIOD);
+    }
+    _lbtSeed ^= Module::getMicros() - start;
+    _lbtSeed ^= Module::getMicros() << 16;
+    setMode(prevMode);
+
+    if(_lbtSeed == 0) {
+      _lbtSeed = 1;
+    }
+  }
+
+  // xorshift32
+  _lbtSeed ^= _lbtSeed << 13;
+  _lbtSeed ^= _lbtSeed >> 17;
+  _lbtSeed ^= _lbtSeed << 5;
+  return(_lbtSeed);
+}
+
 void SX127x::clearIRQFlags() {
   int16_t modem = getActiveModem();
   if(modem == SX127X_LORA) {
@@ -1043,6 +2378,86 @@ void SX127x::clearFIFO(size_t count) {
   }
 }
 
+uint8_t SX127x::getCipherOverhead() {
+  if(_cipher == NULL) {
+    return(0);
+  }
+  return(_cipher->getHeaderLength() + _cipher->getTagLength());
+}
+
+void SX127x::writePayload(uint8_t* data, size_t len) {
+  if(_cipher == NULL) {
+    _mod->SPIwriteRegisterBurst(SX127X_REG_FIFO, data, len);
+    return;
+  }
+
+  // header
+  uint8_t buff[SX127X_CIPHER_CHUNK > PAYLOAD_CIPHER_MAX_OVERHEAD ? SX127X_CIPHER_CHUNK : PAYLOAD_CIPHER_MAX_OVERHEAD];
+  _cipher->beginEncrypt(buff);
+  _mod->SPIwriteRegisterBurst(SX127X_REG_FIFO, buff, _cipher->getHeaderLength());
+
+  // payload is encrypted chunk by chunk as it is written to FIFO, user data is left unchanged
+  for(size_t pos = 0; pos < len; pos += SX127X_CIPHER_CHUNK) {
+    size_t chunk = len - pos;
+    if(chunk > SX127X_CIPHER_CHUNK) {
+      chunk = SX127X_CIPHER_CHUNK;
+    }
+    memcpy(buff, data + pos, chunk);
+    _cipher->encrypt(buff, chunk);
+    _mod->SPIwriteRegisterBurst(SX127X_REG_FIFO, buff, chunk);
+  }
+
+  // tag
+  _cipher->finishEncrypt(buff);
+  _mod->SPIwriteRegisterBurst(SX127X_REG_FIFO, buff, _cipher->getTagLength());
+}
+
+int16_t SX127x::readPayload(uint8_t* data, size_t len, size_t packetLen) {
+  if(_cipher == NULL) {
+    _mod->SPIreadRegisterBurst(SX127X_REG_FIFO, len, data);
+    if(packetLen > len) {
+      clearFIFO(packetLen - len);
+    }
+    return(ERR_NONE);
+  }
+
+  // header
+  uint8_t buff[SX127X_CIPHER_CHUNK > PAYLOAD_CIPHER_MAX_OVERHEAD ? SX127X_CIPHER_CHUNK : PAYLOAD_CIPHER_MAX_OVERHEAD];
+  _mod->SPIreadRegisterBurst(SX127X_REG_FIFO, _cipher->getHeaderLength(), buff);
+  _cipher->beginDecrypt(buff);
+
+  // tag covers the whole packet, so it is always read up to the actual packet end
+  size_t toBuffer = (len < packetLen) ? len : packetLen;
+
+  // payload is decrypted in place chunk by chunk as it is drained from FIFO
+  for(size_t pos = 0; pos < toBuffer; pos += SX127X_CIPHER_CHUNK) {
+    size_t chunk = toBuffer - pos;
+    if(chunk > SX127X_CIPHER_CHUNK) {
+      chunk = SX127X_CIPHER_CHUNK;
+    }
+    _mod->SPIreadRegisterBurst(SX127X_REG_FIFO, chunk, data + pos);
+    _cipher->decrypt(data + pos, chunk);
+  }
+
+  // bytes that do not fit into user buffer are only authenticated
+  for(size_t pos = toBuffer; pos < packetLen; pos += SX127X_CIPHER_CHUNK) {
+    size_t chunk = packetLen - pos;
+    if(chunk > SX127X_CIPHER_CHUNK) {
+      chunk = SX127X_CIPHER_CHUNK;
+    }
+    _mod->SPIreadRegisterBurst(SX127X_REG_FIFO, chunk, buff);
+    _cipher->decrypt(buff, chunk);
+  }
+
+  // tag, unverified plaintext is not left in user buffer
+  _mod->SPIreadRegisterBurst(SX127X_REG_FIFO, _cipher->getTagLength(), buff);
+  if(!_cipher->finishDecrypt(buff)) {
+    memset(data, 0x00, toBuffer);
+    return(ERR_MIC_MISMATCH);
+  }
+  return(ERR_NONE);
+}
+
 #ifdef RADIOLIB_DEBUG
 void SX127x::regDump() {
   RADIOLIB_DEBUG_PRINTLN();
@@ -1067,3 +2482,46 @@ void SX127x::regDump() {
   }
 }
 #endif
+
+SX127xChannelTable::SX127xChannelTable() {
+  _numChannels = 0;
+  for(size_t i = 0; i < SX127X_CHANNEL_TABLE_SIZE; i++) {
+    _frf[i][0] = 0;
+    _frf[i][1] = 0;
+    _frf[i][2] = 0;
+  }
+}
+
+int16_t SX127xChannelTable::setPlan(uint32_t baseFreq, uint32_t spacing, uint8_t numChannels) {
+  if(numChannels > SX127X_CHANNEL_TABLE_SIZE) {
+    return(ERR_INVALID_FREQUENCY);
+  }
+
+  _numChannels = 0;
+  for(uint8_t i = 0; i < numChannels; i++) {
+    setChannel(i, baseFreq + (uint32_t)i * spacing);
+  }
+  return(ERR_NONE);
+}
+
+int16_t SX127xChannelTable::setChannel(uint8_t channel, uint32_t freq) {
+  if(channel >= SX127X_CHANNEL_TABLE_SIZE) {
+    return(ERR_INVALID_FREQUENCY);
+  }
+
+  // precompute register values
+  uint32_t FRF = SX127x::calculateFrfHz(freq);
+  _frf[channel][0] = (FRF >> 16) & 0xFF;
+  _frf[channel][1] = (FRF >> 8) & 0xFF;
+  _frf[channel][2] = FRF & 0xFF;
+
+  // channels skipped in between are left at 0
+  if(channel >= _numChannels) {
+    _numChannels = channel + 1;
+  }
+  return(ERR_NONE);
+}
+
+uint32_t SX127xChannelTable::getFrf(uint8_t channel) const {
+  return(((uint32_t)_frf[channel][0] << 16) | ((uint32_t)_frf[channel][1] << 8) | (uint32_t)_frf[channel][2]);
+}
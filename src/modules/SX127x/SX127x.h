@@ -5,14 +5,49 @@
 #include "../../Module.h"
 
 #include "../../protocols/PhysicalLayer/PhysicalLayer.h"
+#include "../../protocols/PayloadCipher/PayloadCipher.h"
 
 // SX127x physical layer properties
 #define SX127X_FREQUENCY_STEP_SIZE                    61.03515625
 #define SX127X_MAX_PACKET_LENGTH                      255
 #define SX127X_MAX_PACKET_LENGTH_FSK                  64
+#define SX127X_MAX_PACKET_LENGTH_SPLIT                128
+#define SX127X_MAX_PACKET_LENGTH_STREAM               2047
 #define SX127X_CRYSTAL_FREQ                           32.0
 #define SX127X_DIV_EXPONENT                           19
 
+// channel table size, can be overridden before including the library
+#ifndef SX127X_CHANNEL_TABLE_SIZE
+  #if defined(__AVR__)
+    #define SX127X_CHANNEL_TABLE_SIZE                 16
+  #else
+    #define SX127X_CHANNEL_TABLE_SIZE                 64
+  #endif
+#endif
+
+// channel indices and count are 8-bit
+#if SX127X_CHANNEL_TABLE_SIZE > 255
+  #error "SX127X_CHANNEL_TABLE_SIZE must not exceed 255"
+#endif
+
+// FSK FIFO streaming
+#define SX127X_FIFO_SIZE                              64
+#define SX127X_FIFO_STREAM_THRESHOLD                  32          // FIFO level at which the FIFO is refilled/drained
+#define SX127X_FIFO_STREAM_CHUNK                      32          // bytes moved per refill/drain, must fit into FIFO_SIZE - FIFO_STREAM_THRESHOLD
+#define SX127X_CIPHER_CHUNK                           16          // payload bytes encrypted/decrypted per SPI burst when payload cipher is set
+
+// duty-cycled receive
+#define SX127X_CAD_SNIFF_MARGIN                       8           // LoRa preamble symbols reserved for detection and receiver lock
+#define SX127X_SEQ_RX_WINDOW_BYTES                    4           // FSK preamble bytes needed for preamble detection
+#define SX127X_SEQ_RX_STARTUP_TIME                    500         // FSK receiver start-up from sleep in us
+
+// RSSI sweep
+#define SX127X_SWEEP_PLL_LOCK_TIME                    60          // maximum PLL lock time after receiver restart in us
+
+// random number generator seeding
+#define SX127X_RANDOM_SETTLE_TIME                     1000        // receiver start-up before the first RSSI sample in us
+#define SX127X_RANDOM_SAMPLE_PERIOD                   50          // interval between RSSI samples in us
+
 // SX127x series common LoRa registers
 #define SX127X_REG_FIFO                               0x00
 #define SX127X_REG_OP_MODE                            0x01
@@ -131,6 +166,11 @@
 #define SX127X_HOP_PERIOD_OFF                         0b00000000  //  7     0     number of periods between frequency hops; 0 = disabled
 #define SX127X_HOP_PERIOD_MAX                         0b11111111  //  7     0
 
+// SX127X_REG_HOP_CHANNEL
+#define SX127X_HOP_CHANNEL_PLL_TIMEOUT                0b10000000  //  7     7     PLL failed to lock during TX/RX/CAD
+#define SX127X_HOP_CHANNEL_CRC_ON_PAYLOAD             0b01000000  //  6     6     CRC is enabled in received packet header
+#define SX127X_HOP_CHANNEL_PRESENT                    0b00111111  //  5     0     current frequency hopping channel
+
 // SX127X_REG_DIO_MAPPING_1
 #define SX127X_DIO0_RX_DONE                           0b00000000  //  7     6
 #define SX127X_DIO0_TX_DONE                           0b01000000  //  7     6
@@ -161,9 +201,15 @@
 
 // SX127X_REG_FIFO_TX_BASE_ADDR
 #define SX127X_FIFO_TX_BASE_ADDR_MAX                  0b00000000  //  7     0     allocate the entire FIFO buffer for TX only
+#define SX127X_FIFO_TX_BASE_ADDR_SPLIT                0b10000000  //  7     0     allocate the upper half of FIFO buffer for TX
 
 // SX127X_REG_FIFO_RX_BASE_ADDR
 #define SX127X_FIFO_RX_BASE_ADDR_MAX                  0b00000000  //  7     0     allocate the entire FIFO buffer for RX only
+#define SX127X_FIFO_RX_BASE_ADDR_SPLIT                0b00000000  //  7     0     allocate the lower half of FIFO buffer for RX
+
+// SX127X_REG_MAX_PAYLOAD_LENGTH
+#define SX127X_MAX_PAYLOAD_LENGTH_FULL                0xFF        //  7     0     maximum received payload length: entire FIFO buffer (default)
+#define SX127X_MAX_PAYLOAD_LENGTH_SPLIT               0x80        //  7     0                                      lower half of FIFO buffer
 
 // SX127X_REG_SYNC_WORD
 #define SX127X_SYNC_WORD                              0x12        //  7     0     default LoRa sync word
@@ -509,6 +555,10 @@
 #define SX127X_DIO1_PACK_FIFO_EMPTY                   0b00010000  //  5     4
 #define SX127X_DIO1_PACK_FIFO_FULL                    0b00100000  //  5     4
 #define SX127X_DIO2_CONT_DATA                         0b00000000  //  3     2
+#define SX127X_DIO2_PACK_FIFO_FULL                    0b00000000  //  3     2
+#define SX127X_DIO2_PACK_RX_READY                     0b00000100  //  3     2
+#define SX127X_DIO2_PACK_TIMEOUT                      0b00001000  //  3     2
+#define SX127X_DIO2_PACK_SYNC_ADDRESS                 0b00001100  //  3     2
 
 // SX1272_REG_PLL_HOP + SX1278_REG_PLL_HOP
 #define SX127X_FAST_HOP_OFF                           0b00000000  //  7     7     carrier frequency validated when FRF registers are written
@@ -524,6 +574,117 @@
 #define SX127X_PLL_BANDWIDTH_225_KHZ                  0b10000000  //  7     6                    225 kHz
 #define SX127X_PLL_BANDWIDTH_300_KHZ                  0b11000000  //  7     6                    300 kHz (default)
 
+/*!
+  \class SX127xChannelTable
+
+  \brief Channel plan with precomputed frequency register values. Used to retune SX127x modules with a single SPI burst (see SX127x::retune).
+*/
+class SX127xChannelTable {
+  public:
+    /*!
+      \brief Default constructor. Creates empty channel table.
+    */
+    SX127xChannelTable();
+
+    /*!
+      \brief Fills the table with evenly spaced channels.
+
+      \param baseFreq Frequency of the first channel in Hz.
+
+      \param spacing Channel spacing in Hz.
+
+      \param numChannels Number of channels. Maximum is SX127X_CHANNEL_TABLE_SIZE.
+
+      \returns \ref status_codes
+    */
+    int16_t setPlan(uint32_t baseFreq, uint32_t spacing, uint8_t numChannels);
+
+    /*!
+      \brief Sets frequency of a single channel. Table is extended when channel is past the current number of channels.
+
+      \param channel Channel index. Maximum is SX127X_CHANNEL_TABLE_SIZE - 1.
+
+      \param freq Channel frequency in Hz.
+
+      \returns \ref status_codes
+    */
+    int16_t setChannel(uint8_t channel, uint32_t freq);
+
+    /*!
+      \brief Gets number of channels in the table.
+
+      \returns Number of channels.
+    */
+    uint8_t getNumChannels() const { return(_numChannels); }
+
+    /*!
+      \brief Gets raw frequency value of a channel.
+
+      \param channel Channel index.
+
+      \returns Raw 24-bit frequency value.
+    */
+    uint32_t getFrf(uint8_t channel) const;
+
+    /*!
+      \brief Gets raw frequency register values of a channel, ordered from FRF_MSB to FRF_LSB.
+
+      \param channel Channel index.
+
+      \returns Pointer to 3 frequency register bytes.
+    */
+    const uint8_t* getFrfBytes(uint8_t channel) const { return(_frf[channel]); }
+
+#ifndef RADIOLIB_GODMODE
+  private:
+#endif
+    uint8_t _frf[SX127X_CHANNEL_TABLE_SIZE][3];
+    uint8_t _numChannels;
+};
+
+/*!
+  \struct SX127xProfile
+
+  \brief Precomputed %LoRa modem and output power register values. Built by SX127x::buildProfile and applied by SX127x::applyProfile
+  using raw register writes only, e.g. to switch data rates recommended by ADR.
+*/
+struct SX127xProfile {
+  /*!
+    \brief Spreading factor.
+  */
+  uint8_t sf;
+
+  /*!
+    \brief Bandwidth in kHz.
+  */
+  float bw;
+
+  /*!
+    \brief Coding rate denominator.
+  */
+  uint8_t cr;
+
+  /*!
+    \brief Output power in dBm.
+  */
+  int8_t power;
+
+  /*!
+    \brief Register values, in order: MODEM_CONFIG_1, MODEM_CONFIG_2, MODEM_CONFIG_3, DETECT_OPTIMIZE, DETECTION_THRESHOLD, PA_CONFIG and PA_DAC.
+  */
+  uint8_t regs[7];
+
+  /*!
+    \brief Address of MODEM_CONFIG_3 register, 0 if the module does not have one.
+  */
+  uint8_t modemConfig3Addr;
+
+  /*!
+    \brief Address of PA_DAC register.
+  */
+  uint8_t paDacAddr;
+};
+
 /*!
   \class SX127x
 
@@ -619,7 +780,7 @@ class SX127x: public PhysicalLayer {
     int16_t beginFSK(uint8_t chipVersion, float br, float freqDev, float rxBw, uint8_t currentLimit, uint16_t preambleLength, bool enableOOK);
 
     /*!
-      \brief Binary transmit method. Will transmit arbitrary binary data up to 255 bytes long using %LoRa or up to 63 bytes using FSK modem.
+      \brief Binary transmit method. Will transmit arbitrary binary data up to 255 bytes long using %LoRa or up to 2047 bytes using FSK modem (packets longer than 63 bytes are streamed through FIFO).
       For overloads to transmit Arduino String or C-string, see PhysicalLayer::transmit.
 
       \param data Binary data that will be transmitted.
@@ -633,7 +794,7 @@ class SX127x: public PhysicalLayer {
     int16_t transmit(uint8_t* data, size_t len, uint8_t addr = 0);
 
     /*!
-      \brief Binary receive method. Will attempt to receive arbitrary binary data up to 255 bytes long using %LoRa or up to 63 bytes using FSK modem.
+      \brief Binary receive method. Will attempt to receive arbitrary binary data up to 255 bytes long using %LoRa or up to 2047 bytes using FSK modem (packets longer than 64 bytes are streamed through FIFO).
       For overloads to receive Arduino String, see PhysicalLayer::receive.
 
       \param data Pointer to array to save the received binary data.
@@ -644,6 +805,54 @@ class SX127x: public PhysicalLayer {
     */
     int16_t receive(uint8_t* data, size_t len);
 
+    /*!
+      \brief Binary receive method with timeout. In %LoRa mode, symbol timeout is set for the duration of this call.
+      In FSK mode, sync address timeout is used unless timeouts were configured by SX127x::setRxTimeout.
+
+      \param data Pointer to array to save the received binary data.
+
+      \param len Number of bytes that will be received. Must be known in advance for binary transmissions.
+
+      \param timeout Maximum time to wait for the start of packet in microseconds. Packet that started within the timeout is received completely.
+
+      \returns \ref status_codes
+    */
+    int16_t receive(uint8_t* data, size_t len, uint32_t timeout);
+
+    /*!
+      \brief Blocking transmit followed by a single receive window opened precisely rxDelay microseconds after the end of transmission.
+      Receiver configuration is written before transmission starts, so that only a single SPI transaction is needed to open the window.
+      Window length is set by SX127x::setSymbolTimeout. Only available in %LoRa mode.
+
+      \param txData Binary data that will be transmitted.
+
+      \param txLen Length of binary data to transmit (in bytes).
+
+      \param rxData Pointer to array to save the received binary data.
+
+      \param rxLen Number of bytes that will be received. Required for %LoRa spreading factor 6.
+
+      \param rxDelay Delay between end of transmission (TxDone) and start of reception in microseconds.
+
+      \returns \ref status_codes
+    */
+    int16_t transmitReceive(uint8_t* txData, size_t txLen, uint8_t* rxData, size_t rxLen, uint32_t rxDelay);
+
+    /*!
+      \brief Blocking duty-cycled (wake-on-radio) receive method. Sniff period is derived from preamble length set by SX127x::setPreambleLength,
+      transmitter has to use the same preamble length. In %LoRa mode, the module sleeps between channel activity detections
+      and only switches to receive mode when preamble is detected. In FSK mode, the built-in sequencer is used (see SX127x::startReceiveDutyCycle).
+
+      \param data Pointer to array to save the received binary data.
+
+      \param len Number of bytes that will be received. Must be known in advance for binary transmissions.
+
+      \param timeout Maximum time to wait for a packet in microseconds. Set to 0 to wait indefinitely. Defaults to 0.
+
+      \returns \ref status_codes
+    */
+    int16_t receiveDutyCycle(uint8_t* data, size_t len, uint32_t timeout = 0);
+
     /*!
       \brief Performs scan for valid %LoRa preamble in the current channel.
 
@@ -651,6 +860,78 @@ class SX127x: public PhysicalLayer {
     */
     int16_t scanChannel();
 
+    /*!
+      \brief Performs channel activity detection on every combination of the supplied frequencies and spreading factors.
+      Combinations are scanned spreading factor first, and only registers that differ from the previous step are written. Original frequency
+      and spreading factor are restored afterwards. Only available in %LoRa mode.
+
+      \param frf Array of raw frequency values (see SX127x::calculateFrf) to scan.
+
+      \param numChannels Number of frequencies in frf array.
+
+      \param sf Array of spreading factors to scan. Allowed values range from 7 to 12.
+
+      \param numSf Number of spreading factors in sf array. Maximum is 8.
+
+      \param activity Array of numChannels bytes to save the results to. Bit n of activity[i] is set when preamble was detected on frf[i] using sf[n].
+
+      \returns \ref status_codes
+    */
+    int16_t scanActivity(const uint32_t* frf, uint8_t numChannels, const uint8_t* sf, uint8_t numSf, uint8_t* activity);
+
+    /*!
+      \brief Measures RSSI on every supplied frequency without leaving receive mode. Each step is a single burst frequency write and receiver restart with PLL lock,
+      followed by the shortest wait that gives a fresh RSSI value for the current smoothing (see SX127x::setRSSIConfig) and receiver bandwidth.
+      Original frequency is restored afterwards and the module is left in standby. Only available in FSK mode.
+
+      \param frf Array of raw frequency values (see SX127x::calculateFrf) to measure.
+
+      \param numChannels Number of frequencies in frf array.
+
+      \param rssi Array of numChannels values to save the RSSI to, in dBm.
+
+      \returns \ref status_codes
+    */
+    int16_t sweepRSSI(const uint32_t* frf, uint16_t numChannels, float* rssi);
+
+    /*!
+      \brief Calculates raw 24-bit frequency register value.
+
+      \param freq Carrier frequency in MHz.
+
+      \returns Raw frequency value.
+    */
+    static uint32_t calculateFrf(float freq);
+
+    /*!
+      \brief Calculates raw 24-bit frequency register value using integer arithmetic only. Result is rounded to the nearest frequency step.
+
+      \param freq Carrier frequency in Hz.
+
+      \returns Raw frequency value.
+    */
+    static uint32_t calculateFrfHz(uint32_t freq);
+
+    /*!
+      \brief Retunes the module to a channel from precomputed channel table using a single SPI burst. No verification or mode change is performed;
+      in %LoRa mode, the module must be in sleep or standby. Cached frequency is not updated.
+
+      \param table Channel table to retune from.
+
+      \param channel Channel index.
+
+      \returns \ref status_codes
+    */
+    int16_t retune(const SX127xChannelTable& table, uint8_t channel);
+
+    /*!
+      \brief Services FHSS change channel interrupt by writing frequency of the next hop. Must be called every time DIO1 activates during frequency hopping
+      interrupt-driven transmission or reception (see SX127x::setDio1Action), blocking methods call it automatically. Only available in %LoRa mode.
+
+      \returns \ref status_codes
+    */
+    int16_t fhssChangeChannel();
+
     /*!
       \brief Sets the %LoRa module to sleep to save power. %Module will not be able to transmit or receive any data while in sleep mode.
       %Module will wake up automatically when methods like transmit or receive are called.
@@ -676,6 +957,35 @@ class SX127x: public PhysicalLayer {
     */
     int16_t transmitDirect(uint32_t FRF = 0);
 
+    /*!
+      \brief Transmits a sequence of tones, e.g. for RTTY, AFSK, Morse or Hellschreiber keying. Each symbol selects a channel in tone table,
+      the tone is changed by a single 3-byte burst write, with symbol boundaries paced by Module::waitUntil. The transmitter is left running after the last symbol,
+      call SX127x::standby to stop it. Achieved timing can be checked using SX127x::getToneJitter. Can only be used in FSK mode.
+
+      \param symbols Array of symbols, each one is an index into the tone table.
+
+      \param len Number of symbols.
+
+      \param tones Tone table, e.g. one entry per mark/space frequency.
+
+      \param symbolLength Length of one symbol in microseconds.
+
+      \returns \ref status_codes
+    */
+    int16_t transmitDirectTones(const uint8_t* symbols, size_t len, const SX127xChannelTable& tones, uint32_t symbolLength);
+
+    /*!
+      \brief Gets timing statistics of SX127x::transmitDirectTones, measured as difference between symbol boundary and the tone change.
+
+      \returns Timing statistics of tone changes.
+    */
+    TimingStats getToneJitter() const { return(_toneJitter); }
+
+    /*!
+      \brief Clears timing statistics of tone changes.
+    */
+    void resetToneJitter() { _toneJitter.reset(); }
+
     /*!
       \brief Enables direct reception mode on pins DIO1 (clock) and DIO2 (data).
       While in direct mode, the module will not be able to transmit or receive packets. Can only be activated in FSK mode.
@@ -718,7 +1028,20 @@ class SX127x: public PhysicalLayer {
     void clearDio1Action();
 
     /*!
-      \brief Interrupt-driven binary transmit method. Will start transmitting arbitrary binary data up to 255 bytes long using %LoRa or up to 63 bytes using FSK modem.
+      \brief Set interrupt service routine function to call when DIO2 activates. During FSK packet reception, DIO2 is mapped to Timeout
+      (see SX127x::setRxTimeout). Requires DIO2 pin to be configured in Module constructor.
+
+      \param func Pointer to interrupt service routine.
+    */
+    void setDio2Action(void (*func)(void));
+
+    /*!
+      \brief Clears interrupt service routine to call when DIO2 activates.
+    */
+    void clearDio2Action();
+
+    /*!
+      \brief Interrupt-driven binary transmit method. Will start transmitting arbitrary binary data up to 255 bytes long using %LoRa or up to 2047 bytes using FSK modem (see SX127x::startTransmitStream).
 
       \param data Binary data that will be transmitted.
 
@@ -730,6 +1053,48 @@ class SX127x: public PhysicalLayer {
     */
     int16_t startTransmit(uint8_t* data, size_t len, uint8_t addr = 0);
 
+    /*!
+      \brief Interrupt-driven transmit method that starts transmission at an exact time. Packet and configuration are uploaded in advance
+      and the frequency synthesizer is started, only the final mode change is performed at the deadline. DIO0 will be activated when transmission finishes.
+      Achieved timing can be checked using SX127x::getScheduleJitter.
+
+      \param data Binary data that will be transmitted.
+
+      \param len Length of binary data to transmit (in bytes).
+
+      \param timestamp Time to start the transmission at, as returned by Module::getMicros.
+
+      \param addr Node address to transmit the packet to. Only used in FSK mode.
+
+      \returns \ref status_codes
+    */
+    int16_t scheduleTransmit(uint8_t* data, size_t len, uint32_t timestamp, uint8_t addr = 0);
+
+    /*!
+      \brief Interrupt-driven listen-before-talk transmit method. Packet is uploaded in advance, then channel activity detection is performed.
+      If the channel is free, transmission starts immediately, otherwise the method waits for random binary-exponential backoff and retries.
+      DIO0 will be activated when transmission finishes. Backoff is configured by SX127x::setListenBeforeTalk. Only available in %LoRa mode.
+
+      \param data Binary data that will be transmitted.
+
+      \param len Length of binary data to transmit (in bytes).
+
+      \returns \ref status_codes, PREAMBLE_DETECTED if the channel was busy on all attempts.
+    */
+    int16_t startTransmitLBT(uint8_t* data, size_t len);
+
+    /*!
+      \brief Gets timing statistics of scheduled transmissions, measured as difference between the deadline and the final mode change.
+
+      \returns Timing statistics of SX127x::scheduleTransmit.
+    */
+    TimingStats getScheduleJitter() const { return(_scheduleJitter); }
+
+    /*!
+      \brief Clears timing statistics of scheduled transmissions.
+    */
+    void resetScheduleJitter() { _scheduleJitter.reset(); }
+
     /*!
       \brief Interrupt-driven receive method. DIO0 will be activated when full valid packet is received.
 
@@ -752,6 +1117,75 @@ class SX127x: public PhysicalLayer {
     */
     int16_t readData(uint8_t* data, size_t len);
 
+    /*!
+      \brief Interrupt-driven duty-cycled receive method. The built-in sequencer keeps the module asleep and periodically wakes it up to receive.
+      Sleep and receive window durations are derived from preamble length set by SX127x::setPreambleLength. DIO0 will be activated when full valid packet is received,
+      the sequencer then stops and has to be restarted after SX127x::readData. Only available in FSK mode.
+
+      \returns \ref status_codes
+    */
+    int16_t startReceiveDutyCycle();
+
+    /*!
+      \brief Uploads packet into the TX half of FIFO buffer. Requires split FIFO mode (see SX127x::setFifoSplit). Only available in %LoRa mode.
+      Module must be in standby or single receive mode (SX127x::startReceive with SX127X_RXSINGLE), continuous reception would overwrite the staged packet.
+      FIFO can only be written in standby, so single reception is briefly stopped and restarted, packet that is being received at that moment is lost.
+
+      \param data Binary data that will be transmitted.
+
+      \param len Length of binary data to transmit (in bytes). Maximum is 128 bytes.
+
+      \returns \ref status_codes
+    */
+    int16_t stageTransmit(uint8_t* data, size_t len);
+
+    /*!
+      \brief Interrupt-driven transmit method for packet uploaded by SX127x::stageTransmit. Each staged packet is transmitted only once,
+      calling this method again without staging a new packet returns ERR_NOTHING_STAGED. Only available in %LoRa mode.
+      Can be called directly from receive mode, DIO0 will be activated when transmission finishes.
+
+      \returns \ref status_codes
+    */
+    int16_t startTransmitStaged();
+
+    /*!
+      \brief Interrupt-driven transmit method for FSK packets longer than FIFO. Packets up to 255 bytes are sent in variable length mode,
+      longer packets in fixed length mode with 11-bit length, so the receiver has to expect the exact length. Initial part of the packet is uploaded
+      immediately, the rest has to be uploaded by calling SX127x::fifoService whenever DIO1 (FIFO level) changes. DIO0 will be activated when transmission finishes.
+      Called automatically by SX127x::startTransmit for packets that do not fit into FIFO. Only available in FSK mode.
+
+      \param data Binary data that will be transmitted. Must remain valid until transmission finishes.
+
+      \param len Length of binary data to transmit (in bytes). Maximum is 2047 bytes.
+
+      \param addr Node address to transmit the packet to.
+
+      \returns \ref status_codes
+    */
+    int16_t startTransmitStream(uint8_t* data, size_t len, uint8_t addr = 0);
+
+    /*!
+      \brief Interrupt-driven receive method for FSK packets longer than FIFO. Lengths up to 255 bytes use variable length mode, longer packets fixed length mode.
+      Received data has to be drained by calling SX127x::fifoService whenever DIO1 (FIFO level) activates. Only available in FSK mode.
+
+      \param data Pointer to array to save the received binary data. Must remain valid until reception finishes.
+
+      \param len Size of data array in variable length mode, exact packet length in fixed length mode. Maximum is 2047 bytes.
+
+      \returns \ref status_codes
+    */
+    int16_t startReceiveStream(uint8_t* data, size_t len);
+
+    /*!
+      \brief Refills (transmission) or drains (reception) FIFO in chunks of SX127X_FIFO_STREAM_CHUNK bytes. Intended to be called from DIO1 interrupt
+      or event loop while stream started by SX127x::startTransmitStream or SX127x::startReceiveStream is active. Packet configuration is restored
+      and the module is set to standby once the stream finishes. When the module discards a packet without PayloadReady (e.g. CRC error) and
+      synchronizes to the next one, reception of the stream starts over.
+
+      \returns True when the stream has finished (or no stream is active), false otherwise.
+    */
+    bool fifoService();
+
 
     // configuration methods
 
@@ -773,6 +1207,69 @@ class SX127x: public PhysicalLayer {
     */
     int16_t setSyncWord(uint8_t syncWord);
 
+    /*!
+      \brief Sets %LoRa single receive timeout. Only available in %LoRa mode.
+
+      \param symbols Timeout in %LoRa symbols. Allowed values range from 4 to 1023.
+
+      \returns \ref status_codes
+    */
+    int16_t setSymbolTimeout(uint16_t symbols);
+
+    /*!
+      \brief Sets FSK hardware receive timeouts, measured from the start of reception. Timeout is signalled on DIO2 (see SX127x::setDio2Action),
+      which SX127x::receive waits for instead of relying on system time. When DIO2 pin is not configured, Timeout flag in IRQ_FLAGS_1 is read instead.
+      When no timeout is set, SX127x::receive uses sync address timeout of 500 % of expected time-on-air. Timeout resolution is 16 bit periods, so this method must be called again after bit rate change. Only available in FSK mode.
+
+      \param rssiTimeout Timeout for RSSI threshold to be exceeded in microseconds. Set to 0 to disable.
+
+      \param preambleTimeout Timeout for preamble detection in microseconds. Set to 0 to disable. Defaults to 0.
+
+      \param syncTimeout Timeout for sync address match in microseconds. Set to 0 to disable. Defaults to 0.
+
+      \returns \ref status_codes
+    */
+    int16_t setRxTimeout(uint32_t rssiTimeout, uint32_t preambleTimeout = 0, uint32_t syncTimeout = 0);
+
+    /*!
+      \brief Enables automatic receiver restart after a valid packet was received, allowing back-to-back packet reception.
+      When enabled, SX127x::readData keeps the receiver running instead of switching to standby, so SX127x::startReceive only has to be called once.
+      Only available in FSK mode.
+
+      \param enable Set to true to enable automatic restart.
+
+      \param waitForPllLock Set to true to wait for PLL lock before restarting (required when frequency was changed). Defaults to false.
+
+      \returns \ref status_codes
+    */
+    int16_t setAutoRestartRx(bool enable, bool waitForPllLock = false);
+
+    /*!
+      \brief Enables %LoRa frequency hopping spread spectrum. Each packet starts at frfTable[0], and the module hops to the next channel every hopPeriod symbols.
+      Hop period should be chosen so that time spent on a single channel fits the local dwell time limit (e.g. 400 ms for FCC). Only available in %LoRa mode.
+
+      \param hopPeriod Number of symbols between hops. Set to 0 to disable frequency hopping and return to frequency set by setFrequency.
+
+      \param frfTable Array of raw frequency values (see SX127x::calculateFrf) to hop through. The array is not copied and must remain valid while hopping is enabled.
+
+      \param numChannels Number of channels in frfTable.
+
+      \returns \ref status_codes
+    */
+    int16_t setFrequencyHopping(uint8_t hopPeriod, const uint32_t* frfTable = NULL, uint8_t numChannels = 0);
+
+    /*!
+      \brief Configures listen-before-talk backoff used by SX127x::startTransmitLBT.
+      Before retry n (counting from 0), the module waits for random number of slots from 0 to 2^min(n + 1, maxExponent) - 1.
+
+      \param maxAttempts Maximum number of channel activity detections before giving up. Defaults to 8.
+
+      \param slotLength Backoff slot length in microseconds. Set to 0 to use one %LoRa symbol. Defaults to 0.
+
+      \param maxExponent Maximum backoff exponent. Allowed values range from 1 to 15. Defaults to 6.
+    */
+    void setListenBeforeTalk(uint8_t maxAttempts = 8, uint32_t slotLength = 0, uint8_t maxExponent = 6);
+
     /*!
       \brief Sets current limit for over current protection at transmitter amplifier. Allowed values range from 45 to 120 mA in 5 mA steps and 120 to 240 mA in 10 mA steps.
 
@@ -814,6 +1311,58 @@ class SX127x: public PhysicalLayer {
     */
     virtual float getRSSI() = 0;
 
+    /*!
+      \brief Gets instantaneous RSSI with a single register read, without changing operation mode. The module must already be in receive mode.
+      Intended for frequent sampling, e.g. by NoiseFloor.
+
+      \returns Current RSSI level in dBm.
+    */
+    virtual float getCurrentRSSI() = 0;
+
+    /*!
+      \brief Sets carrier frequency. Allowed values depend on the module variant.
+
+      \param freq Carrier frequency in MHz.
+
+      \returns \ref status_codes
+    */
+    virtual int16_t setFrequency(float freq) = 0;
+
+    /*!
+      \brief Gets the Module instance used by this driver, e.g. to read its interrupt pins.
+
+      \returns Pointer to Module instance.
+    */
+    Module* getMod();
+
+    /*!
+      \brief Precomputes register values for the given %LoRa modem settings and output power. Header mode follows the spreading factor
+      (implicit for SF6, explicit otherwise), the same as in setSpreadingFactor. Other settings (CRC, gain, ...) are taken from the current configuration.
+      Allowed values are the same as for the corresponding setters.
+
+      \param sf Spreading factor.
+
+      \param bw Bandwidth in kHz.
+
+      \param cr Coding rate denominator.
+
+      \param power Output power in dBm.
+
+      \param profile Structure to save the register values to.
+
+      \returns \ref status_codes
+    */
+    virtual int16_t buildProfile(uint8_t sf, float bw, uint8_t cr, int8_t power, SX127xProfile& profile) = 0;
+
+    /*!
+      \brief Applies register profile built by SX127x::buildProfile using raw register writes. Only available in %LoRa mode.
+
+      \param profile Profile to apply.
+
+      \returns \ref status_codes
+    */
+    int16_t applyProfile(const SX127xProfile& profile);
+
     /*!
       \brief Get data rate of the latest transmitted packet.
 
@@ -902,6 +1451,23 @@ class SX127x: public PhysicalLayer {
     */
     size_t getPacketLength(bool update = true);
 
+    /*!
+      \brief Calculates expected time-on-air of a packet with the current configuration, including preamble, sync word, header and CRC.
+
+      \param len Payload length in bytes.
+
+      \returns Expected time-on-air in microseconds.
+    */
+    uint32_t getTimeOnAir(size_t len);
+
+    /*!
+      \brief Gets random number from xorshift generator. On first use, the generator is seeded from RSSI noise,
+      so the module is briefly switched to receive mode.
+
+      \returns Random 32-bit number.
+    */
+    uint32_t random32();
+
     /*!
      \brief Set modem in fixed packet length mode. Available in FSK mode only.
 
@@ -932,6 +1498,15 @@ class SX127x: public PhysicalLayer {
     */
     int16_t setRSSIConfig(uint8_t smoothingSamples, int8_t offset = 0);
 
+    /*!
+      \brief Sets RSSI level that triggers RSSI interrupt and starts the receiver when RSSI trigger is used, e.g. to threshold from NoiseFloor::getThreshold. Only available in FSK mode.
+
+      \param rssi RSSI threshold in dBm. Allowed values are in range -127.5 dBm to 0 dBm.
+
+      \returns \ref status_codes
+    */
+    int16_t setRSSIThreshold(float rssi);
+
     /*!
       \brief Sets transmission encoding. Only available in FSK mode.
 
@@ -941,6 +1516,28 @@ class SX127x: public PhysicalLayer {
     */
     int16_t setEncoding(uint8_t encoding);
 
+    /*!
+      \brief Enables/disables split FIFO mode. When enabled, lower half of the 256-byte FIFO buffer is used for reception
+      and upper half for transmission, which allows to stage the next outgoing packet while receiving.
+      Maximum packet length is reduced to 128 bytes. Received packets are written from the RX base address each time the receiver is started,
+      so the receiver should be restarted after each packet. Only available in %LoRa mode.
+
+      \param enableSplit Enable (true) or disable (false) split FIFO mode.
+
+      \returns \ref status_codes
+    */
+    int16_t setFifoSplit(bool enableSplit);
+
+    /*!
+      \brief Sets payload security stage. Payload is encrypted while it is written to FIFO and decrypted in place while it is read,
+      cipher header and tag are added to each packet. Lengths passed to transmit and receive methods, as well as length returned by getPacketLength,
+      only include the payload. Packets must fit into FIFO, so FSK streaming is not used while cipher is set. Tag is always verified
+      over the whole received packet, even when fewer bytes are requested. On tag mismatch, ERR_MIC_MISMATCH is returned and the user buffer is cleared.
+
+      \param cipher Pointer to payload cipher, e.g. AESCipher. Set to NULL to disable.
+    */
+    void setPayloadCipher(PayloadCipher* cipher);
+
     #ifdef RADIOLIB_DEBUG
       void regDump();
     #endif
@@ -956,6 +1553,7 @@ class SX127x: public PhysicalLayer {
     uint8_t _cr;
     float _br;
     float _rxBw;
+    uint8_t _rssiSmoothing;
     bool _ook;
 
     int16_t setFrequencyRaw(float newFreq);
@@ -964,6 +1562,7 @@ class SX127x: public PhysicalLayer {
     int16_t getActiveModem();
     int16_t directMode();
     int16_t setPacketMode(uint8_t mode, uint8_t len);
+    virtual int16_t checkSpreadingFactor(uint8_t sf);
 
 #ifndef RADIOLIB_GODMODE
   private:
@@ -972,12 +1571,51 @@ class SX127x: public PhysicalLayer {
     size_t _packetLength;
     bool _packetLengthQueried; // FSK packet length is the first byte in FIFO, length can only be queried once
     uint8_t _packetLengthConfig;
+    bool _fifoSplit;
+    bool _staged;
+    uint8_t _stagedLength;
+    uint8_t _stagedDioMapping;
+    uint8_t _stagedOpMode;
+    TimingStats _scheduleJitter;
+    TimingStats _toneJitter;
+    uint8_t _lbtMaxAttempts;
+    uint32_t _lbtSlotLength;
+    uint8_t _lbtMaxExponent;
+    uint32_t _lbtSeed;
+    uint16_t _preambleLength;
+    uint8_t _hopPeriod;
+    const uint32_t* _hopTable;
+    uint8_t _hopChannels;
+    uint8_t* _streamData;
+    size_t _streamLen;
+    size_t _streamPacketLen;
+    size_t _streamPos;
+    bool _streamActive;
+    bool _streamTx;
+    uint8_t _streamHeader;
+    uint8_t _streamHeaderLen;
+    bool _streamSync;
+    uint8_t _streamConfig[4];
+    bool _rxTimeoutConfigured;
+    bool _autoRestartRx;
+    PayloadCipher* _cipher;
 
     bool findChip(uint8_t ver);
     int16_t setMode(uint8_t mode);
+    int16_t prepareTransmit(uint8_t* data, size_t len, uint8_t addr);
+    int16_t receiveFSK(uint8_t* data, size_t len, uint32_t timeout);
+    bool rxTimeoutFSK();
+    uint8_t waitForIrq(uint8_t mask, uint32_t timeout);
+    int16_t setSequencerTimer(uint8_t timer, uint32_t period);
+    void writeFrf(uint32_t FRF);
+    int16_t startStream(uint8_t* data, size_t len, bool tx);
+    void finishStream();
     int16_t setActiveModem(uint8_t modem);
     void clearIRQFlags();
     void clearFIFO(size_t count); // used mostly to clear remaining bytes in FIFO after a packet read
+    uint8_t getCipherOverhead();
+    void writePayload(uint8_t* data, size_t len);
+    int16_t readPayload(uint8_t* data, size_t len, size_t packetLen);
 };
 
 #endif
@@ -0,0 +1,125 @@
+#include "ADR.h"
+
+const ADRDataRate ADRDataRatesDefault[ADR_DATA_RATES_DEFAULT_NUM] = {
+  // SF, BW, CR, SNR limit
+  { 12, 125.0, 5, -20.0 },
+  { 11, 125.0, 5, -17.5 },
+  { 10, 125.0, 5, -15.0 },
+  { 9, 125.0, 5, -12.5 },
+  { 8, 125.0, 5, -10.0 },
+  { 7, 125.0, 5, -7.5 }
+};
+
+ADR::ADR(const ADRDataRate* dataRates, uint8_t numDataRates, int8_t minPower, int8_t maxPower, float margin) {
+  _dataRates = dataRates;
+  _numDataRates = numDataRates;
+  _minPower = minPower;
+  _maxPower = maxPower;
+  _margin = margin;
+  reset();
+}
+
+void ADR::reset() {
+  _updateCounter = 0;
+  for(uint8_t i = 0; i < ADR_MAX_PEERS; i++) {
+    _peers[i].count = 0;
+  }
+}
+
+void ADR::addSample(uint32_t peer, float snr, int8_t power) {
+  int16_t index = findPeer(peer);
+  if(index < 0) {
+    // use empty slot, or replace the least recently updated peer
+    index = 0;
+    for(uint8_t i = 0; i < ADR_MAX_PEERS; i++) {
+      if(_peers[i].count == 0) {
+        index = i;
+        break;
+      }
+      if((_updateCounter - _peers[i].lastUpdate) > (_updateCounter - _peers[index].lastUpdate)) {
+        index = i;
+      }
+    }
+    _peers[index].address = peer;
+    _peers[index].pos = 0;
+    _peers[index].count = 0;
+  }
+
+  // normalize to 0 dBm output power, so that samples taken at different power levels can be compared
+  float normalized = 2.0 * (snr - (float)power);
+  if(normalized < -128.0) {
+    normalized = -128.0;
+  } else if(normalized > 127.0) {
+    normalized = 127.0;
+  }
+
+  // save the sample
+  ADRPeer& p = _peers[index];
+  p.snr[p.pos] = (int8_t)normalized;
+  p.pos = (p.pos + 1) % ADR_HISTORY_SIZE;
+  if(p.count < ADR_HISTORY_SIZE) {
+    p.count++;
+  }
+  p.lastUpdate = ++_updateCounter;
+}
+
+bool ADR::getRecommendation(uint32_t peer, uint8_t* dataRate, int8_t* power) const {
+  int16_t index = findPeer(peer);
+  if((index < 0) || (_peers[index].count < ADR_MIN_SAMPLES) || (_numDataRates == 0)) {
+    return(false);
+  }
+
+  // best normalized SNR in history
+  const ADRPeer& p = _peers[index];
+  int8_t best = p.snr[0];
+  for(uint8_t i = 1; i < p.count; i++) {
+    if(p.snr[i] > best) {
+      best = p.snr[i];
+    }
+  }
+  float snrMax = (float)best / 2.0;
+
+  // find the fastest data rate that keeps the margin at some allowed output power
+  for(int16_t dr = _numDataRates - 1; dr >= 0; dr--) {
+    float required = _dataRates[dr].snrLimit + _margin - snrMax;
+    if(required <= (float)_maxPower) {
+      // lowest output power that keeps the margin
+      int8_t pwr = (int8_t)ceil(required);
+      if(pwr < _minPower) {
+        pwr = _minPower;
+      }
+
+      // SX127x PA_BOOST only allows 20 dBm above 17 dBm, skip this data rate if that is over the limit
+      if((pwr > 17) && (pwr < 20)) {
+        if(_maxPower < 20) {
+          continue;
+        }
+        pwr = 20;
+      }
+      *dataRate = dr;
+      *power = pwr;
+      return(true);
+    }
+  }
+
+  // link is too weak even for the slowest data rate
+  *dataRate = 0;
+  *power = ((_maxPower > 17) && (_maxPower < 20)) ? 17 : _maxPower;
+  return(true);
+}
+
+void ADR::removePeer(uint32_t peer) {
+  int16_t index = findPeer(peer);
+  if(index >= 0) {
+    _peers[index].count = 0;
+  }
+}
+
+int16_t ADR::findPeer(uint32_t peer) const {
+  for(uint8_t i = 0; i < ADR_MAX_PEERS; i++) {
+    if((_peers[i].count > 0) && (_peers[i].address == peer)) {
+      return(i);
+    }
+  }
+  return(-1);
+}
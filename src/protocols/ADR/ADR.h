@@ -0,0 +1,144 @@
+#ifndef _RADIOLIB_ADR_H
+#define _RADIOLIB_ADR_H
+
+#include "../../TypeDef.h"
+
+// number of SNR samples kept per peer
+#ifndef ADR_HISTORY_SIZE
+  #if defined(__AVR__)
+    #define ADR_HISTORY_SIZE                          8
+  #else
+    #define ADR_HISTORY_SIZE                          20
+  #endif
+#endif
+
+// number of tracked peers
+#ifndef ADR_MAX_PEERS
+  #if defined(__AVR__)
+    #define ADR_MAX_PEERS                             4
+  #else
+    #define ADR_MAX_PEERS                             32
+  #endif
+#endif
+
+#define ADR_MIN_SAMPLES                               4           // samples needed before data rate is changed
+#define ADR_MARGIN                                    10.0        // default installation margin in dB
+
+// number of data rates in ADRDataRatesDefault
+#define ADR_DATA_RATES_DEFAULT_NUM                    6
+
+/*!
+  \struct ADRDataRate
+
+  \brief %LoRa data rate and the lowest SNR it can still be demodulated at.
+*/
+struct ADRDataRate {
+  /*!
+    \brief Spreading factor.
+  */
+  uint8_t sf;
+
+  /*!
+    \brief Bandwidth in kHz.
+  */
+  float bw;
+
+  /*!
+    \brief Coding rate denominator.
+  */
+  uint8_t cr;
+
+  /*!
+    \brief Demodulation SNR limit in dB.
+  */
+  float snrLimit;
+};
+
+/*!
+  \brief Built-in data rate table, ordered from slowest to fastest: SF12 to SF7 at 125 kHz and coding rate 4/5.
+*/
+extern const ADRDataRate ADRDataRatesDefault[ADR_DATA_RATES_DEFAULT_NUM];
+
+/*!
+  \class ADR
+
+  \brief Adaptive data rate engine. Keeps short SNR history for each peer, normalized to 0 dBm output power, and recommends
+  the fastest data rate and lowest output power that keep the configured margin above demodulation limit.
+  Recommended data rate is an index into the data rate table, e.g. to select register profile prebuilt by SX127x::buildProfile.
+*/
+class ADR {
+  public:
+    /*!
+      \brief Default constructor.
+
+      \param dataRates Data rate table, ordered from slowest to fastest. Defaults to ADRDataRatesDefault.
+
+      \param numDataRates Number of entries in data rate table.
+
+      \param minPower Lowest output power to recommend in dBm. Defaults to 2 dBm.
+
+      \param maxPower Highest output power to recommend in dBm. Defaults to 17 dBm.
+
+      \param margin Installation margin above demodulation limit in dB. Defaults to ADR_MARGIN.
+    */
+    ADR(const ADRDataRate* dataRates = ADRDataRatesDefault, uint8_t numDataRates = ADR_DATA_RATES_DEFAULT_NUM, int8_t minPower = 2, int8_t maxPower = 17, float margin = ADR_MARGIN);
+
+    /*!
+      \brief Forgets all peers.
+    */
+    void reset();
+
+    /*!
+      \brief Records SNR of packet received from a peer. When the table is full, the least recently updated peer is replaced.
+
+      \param peer Peer address.
+
+      \param snr Packet SNR in dB, e.g. from SX127x::getSNR.
+
+      \param power Output power the peer transmitted the packet with, in dBm.
+    */
+    void addSample(uint32_t peer, float snr, int8_t power);
+
+    /*!
+      \brief Gets recommended data rate and output power for a peer.
+
+      \param peer Peer address.
+
+      \param dataRate Pointer to variable to save the index of recommended data rate to.
+
+      \param power Pointer to variable to save recommended output power to, in dBm.
+
+      \returns Whether a recommendation is available, i.e. the peer has at least ADR_MIN_SAMPLES samples.
+    */
+    bool getRecommendation(uint32_t peer, uint8_t* dataRate, int8_t* power) const;
+
+    /*!
+      \brief Forgets a single peer, e.g. after it changed its data rate outside ADR.
+
+      \param peer Peer address.
+    */
+    void removePeer(uint32_t peer);
+
+#ifndef RADIOLIB_GODMODE
+  private:
+#endif
+    struct ADRPeer {
+      uint32_t address;
+      uint32_t lastUpdate;
+      int8_t snr[ADR_HISTORY_SIZE]; // SNR normalized to 0 dBm output power, in 0.5 dB units
+      uint8_t pos;
+      uint8_t count;
+    };
+
+    const ADRDataRate* _dataRates;
+    uint8_t _numDataRates;
+    int8_t _minPower;
+    int8_t _maxPower;
+    float _margin;
+    uint32_t _updateCounter;
+    ADRPeer _peers[ADR_MAX_PEERS];
+
+    int16_t findPeer(uint32_t peer) const;
+};
+
+#endif
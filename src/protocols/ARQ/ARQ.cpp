@@ -0,0 +1,256 @@
+#include "ARQ.h"
+
+ARQClient::ARQClient(PhysicalLayer* phy, uint8_t fragmentSize) {
+  _phy = phy;
+  _fragmentSize = fragmentSize;
+  if((_fragmentSize == 0) || (_fragmentSize > ARQ_MAX_FRAGMENT_SIZE)) {
+    _fragmentSize = ARQ_FRAGMENT_SIZE;
+  }
+  _window = 0;
+  _session = 0;
+  _sessionInit = false;
+  _lastSession = 0;
+  _lastNumFragments = 0;
+  _lastValid = false;
+  _retransmissions = 0;
+}
+
+void ARQClient::setWindowSize(uint8_t window) {
+  _window = (window > ARQ_MAX_WINDOW) ? ARQ_MAX_WINDOW : window;
+}
+
+uint8_t ARQClient::getWindowSize() {
+  if(_window != 0) {
+    return(_window);
+  }
+
+  // waiting for acknowledgement should only take a small fraction of the time spent sending data
+  uint32_t dataTime = _phy->getTimeOnAir(ARQ_DATA_HEADER_LEN + _fragmentSize);
+  uint32_t ackTime = _phy->getTimeOnAir(ARQ_ACK_LEN) + 2*ARQ_TURNAROUND_TIME;
+  if(dataTime == 0) {
+    return(ARQ_MAX_WINDOW);
+  }
+  uint32_t window = (ackTime * ARQ_ACK_OVERHEAD_RATIO + dataTime - 1) / dataTime;
+  if(window < 1) {
+    window = 1;
+  } else if(window > ARQ_MAX_WINDOW) {
+    window = ARQ_MAX_WINDOW;
+  }
+  return(window);
+}
+
+int16_t ARQClient::send(uint8_t* data, size_t len) {
+  // check payload length
+  size_t numFragments = (len + _fragmentSize - 1) / _fragmentSize;
+  if((numFragments == 0) || (numFragments > 0xFFFF)) {
+    return(ERR_PACKET_TOO_LONG);
+  }
+
+  // acknowledgement has to arrive within the receiver turnaround
+  uint8_t window = getWindowSize();
+  uint32_t ackTimeout = _phy->getTimeOnAir(ARQ_ACK_LEN) + 2*ARQ_TURNAROUND_TIME;
+
+  // new session, so that the receiver can tell transfers apart
+  if(!_sessionInit) {
+    _session = _phy->random32();
+    _sessionInit = true;
+  }
+  _session++;
+  uint16_t base = 0;
+  uint32_t acked = 0;
+  uint8_t retries = 0;
+  uint16_t sent = 0;
+  while(base < numFragments) {
+    // find the last fragment of the window that still has to be sent
+    uint16_t end = base + window;
+    if(end > numFragments) {
+      end = numFragments;
+    }
+    uint16_t last = base;
+    for(uint16_t i = base; i < end; i++) {
+      if(!(acked & ((uint32_t)1 << (i - base)))) {
+        last = i;
+      }
+    }
+
+    // send missing fragments of the window
+    for(uint16_t i = base; i < end; i++) {
+      if(acked & ((uint32_t)1 << (i - base))) {
+        continue;
+      }
+
+      size_t offset = (size_t)i * _fragmentSize;
+      size_t fragLen = (len - offset < _fragmentSize) ? (len - offset) : _fragmentSize;
+      _frame[0] = ARQ_TYPE_DATA | ((i == last) ? ARQ_FLAG_ACK_REQUEST : 0x00);
+      _frame[1] = _session;
+      _frame[2] = (i >> 8) & 0xFF;
+      _frame[3] = i & 0xFF;
+      _frame[4] = (numFragments >> 8) & 0xFF;
+      _frame[5] = numFragments & 0xFF;
+      memcpy(_frame + ARQ_DATA_HEADER_LEN, data + offset, fragLen);
+
+      int16_t state = _phy->transmit(_frame, ARQ_DATA_HEADER_LEN + fragLen);
+      RADIOLIB_ASSERT(state);
+      if(i < sent) {
+        _retransmissions++;
+      } else {
+        sent = i + 1;
+      }
+    }
+
+    // wait for acknowledgement
+    uint16_t ackBase;
+    uint32_t ackBitmap;
+    int16_t state = waitForAck(_session, numFragments, &ackBase, &ackBitmap, ackTimeout);
+    if(state != ERR_NONE) {
+      // resend the window
+      retries++;
+      if(retries > ARQ_MAX_RETRIES) {
+        return(ERR_ACK_NOT_RECEIVED);
+      }
+      continue;
+    }
+    retries = 0;
+
+    // move the window, fragments above the first missing one are acknowledged by the bitmap
+    if(ackBase >= base) {
+      base = ackBase;
+      acked = ackBitmap;
+    }
+  }
+
+  return(ERR_NONE);
+}
+
+int16_t ARQClient::receive(uint8_t* data, size_t maxLen, size_t* len, uint32_t timeout) {
+  bool active = false;
+  uint8_t session = 0;
+  uint16_t numFragments = 0;
+  uint16_t base = 0;
+  uint32_t received = 0;
+  size_t lastLen = 0;
+
+  uint32_t lastActivity = Module::getMicros();
+  while(true) {
+    // wait for data fragment, at most until the timeout
+    int16_t state;
+    if(timeout == 0) {
+      state = _phy->receive(_frame, ARQ_DATA_HEADER_LEN + _fragmentSize);
+    } else {
+      uint32_t elapsed = Module::getMicros() - lastActivity;
+      if(elapsed >= timeout) {
+        break;
+      }
+      state = _phy->receive(_frame, ARQ_DATA_HEADER_LEN + _fragmentSize, timeout - elapsed);
+    }
+    if(state != ERR_NONE) {
+      continue;
+    }
+    size_t frameLen = _phy->getPacketLength(false);
+    if((frameLen < ARQ_DATA_HEADER_LEN) || (frameLen > (size_t)(ARQ_DATA_HEADER_LEN + _fragmentSize)) || ((_frame[0] & ARQ_TYPE_MASK) != ARQ_TYPE_DATA)) {
+      continue;
+    }
+    uint8_t frameSession = _frame[1];
+    uint16_t index = ((uint16_t)_frame[2] << 8) | _frame[3];
+    uint16_t total = ((uint16_t)_frame[4] << 8) | _frame[5];
+    bool ackRequest = _frame[0] & ARQ_FLAG_ACK_REQUEST;
+
+    // retransmission from transfer that was already completed, its final acknowledgement was lost
+    if(!active && _lastValid && (frameSession == _lastSession) && (total == _lastNumFragments)) {
+      if(ackRequest) {
+        sendAck(_lastSession, _lastNumFragments, _lastNumFragments, 0);
+      }
+      continue;
+    }
+
+    // first fragment of a new transfer
+    if(!active || (frameSession != session)) {
+      // frame that does not fit can be stray or corrupted, so it only fails the reception when no transfer is in progress
+      if((total == 0) || ((size_t)(total - 1) * _fragmentSize >= maxLen)) {
+        if(active) {
+          continue;
+        }
+        return(ERR_PACKET_TOO_LONG);
+      }
+      active = true;
+      session = frameSession;
+      numFragments = total;
+      base = 0;
+      received = 0;
+    }
+    lastActivity = Module::getMicros();
+
+    // save fragments within the window, all but the last one have full length
+    size_t payloadLen = frameLen - ARQ_DATA_HEADER_LEN;
+    size_t offset = (size_t)index * _fragmentSize;
+    bool isLast = (index == numFragments - 1);
+    if((index >= base) && (index < base + ARQ_MAX_WINDOW) && (index < numFragments) &&
+       (isLast || (payloadLen == _fragmentSize)) && (offset + payloadLen <= maxLen)) {
+      memcpy(data + offset, _frame + ARQ_DATA_HEADER_LEN, payloadLen);
+      if(isLast) {
+        lastLen = payloadLen;
+      }
+
+      // slide the window over all consecutive received fragments
+      received |= ((uint32_t)1 << (index - base));
+      while(received & 0x01) {
+        received >>= 1;
+        base++;
+      }
+    }
+
+    // transfer complete, always acknowledge
+    if(base == numFragments) {
+      sendAck(session, numFragments, base, 0);
+      _lastSession = session;
+      _lastNumFragments = numFragments;
+      _lastValid = true;
+      *len = (size_t)(numFragments - 1) * _fragmentSize + lastLen;
+      return(ERR_NONE);
+    }
+
+    if(ackRequest) {
+      sendAck(session, numFragments, base, received);
+    }
+  }
+
+  return(ERR_RX_TIMEOUT);
+}
+
+int16_t ARQClient::waitForAck(uint8_t session, uint16_t numFragments, uint16_t* base, uint32_t* bitmap, uint32_t timeout) {
+  uint32_t start = Module::getMicros();
+  uint32_t elapsed;
+  while((elapsed = Module::getMicros() - start) < timeout) {
+    // frame buffer is free while waiting
+    uint8_t* ack = _frame;
+    size_t maxLen = (ARQ_DATA_HEADER_LEN + _fragmentSize > ARQ_ACK_LEN) ? (ARQ_DATA_HEADER_LEN + _fragmentSize) : ARQ_ACK_LEN;
+    int16_t state = _phy->receive(ack, maxLen, timeout - elapsed);
+    if(state != ERR_NONE) {
+      continue;
+    }
+
+    // check this is acknowledgement of the current transfer
+    if((_phy->getPacketLength(false) != ARQ_ACK_LEN) || ((ack[0] & ARQ_TYPE_MASK) != ARQ_TYPE_ACK) || (ack[1] != session) ||
+       ((((uint16_t)ack[2] << 8) | ack[3]) != numFragments)) {
+      continue;
+    }
+
+    // acknowledged position can not be past the end of transfer
+    uint16_t ackBase = ((uint16_t)ack[4] << 8) | ack[5];
+    if(ackBase > numFragments) {
+      continue;
+    }
+    *base = ackBase;
+    *bitmap = ((uint32_t)ack[6] << 24) | ((uint32_t)ack[7] << 16) | ((uint32_t)ack[8] << 8) | ack[9];
+    return(ERR_NONE);
+  }
+
+  return(ERR_RX_TIMEOUT);
+}
+
+int16_t ARQClient::sendAck(uint8_t session, uint16_t numFragments, uint16_t base, uint32_t bitmap) {
+  uint8_t ack[ARQ_ACK_LEN] = { ARQ_TYPE_ACK, session, (uint8_t)((numFragments >> 8) & 0xFF), (uint8_t)(numFragments & 0xFF),
+                               (uint8_t)((base >> 8) & 0xFF), (uint8_t)(base & 0xFF),
+                               (uint8_t)((bitmap >> 24) & 0xFF), (uint8_t)((bitmap >> 16) & 0xFF), (uint8_t)((bitmap >> 8) & 0xFF), (uint8_t)(bitmap & 0xFF) };
+  return(_phy->transmit(ack, ARQ_ACK_LEN));
+}
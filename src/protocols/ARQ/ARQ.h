@@ -0,0 +1,111 @@
+#ifndef _RADIOLIB_ARQ_H
+#define _RADIOLIB_ARQ_H
+
+#include "../../TypeDef.h"
+#include "../../Module.h"
+#include "../PhysicalLayer/PhysicalLayer.h"
+
+// frame format
+#define ARQ_TYPE_DATA                                 0x01
+#define ARQ_TYPE_ACK                                  0x02
+#define ARQ_TYPE_MASK                                 0x0F
+#define ARQ_FLAG_ACK_REQUEST                          0x80        // sender waits for acknowledgement after this fragment
+#define ARQ_DATA_HEADER_LEN                           6           // type, session, fragment index (2 bytes), number of fragments (2 bytes)
+#define ARQ_ACK_LEN                                   10          // type, session, number of fragments (2 bytes), first missing fragment (2 bytes), bitmap of following fragments (4 bytes)
+
+// fragment size
+#define ARQ_FRAGMENT_SIZE                             48          // default, small enough to fit into FSK FIFO with header
+#define ARQ_MAX_FRAGMENT_SIZE                         (255 - ARQ_DATA_HEADER_LEN)
+
+// window
+#define ARQ_MAX_WINDOW                                32          // limited by acknowledgement bitmap size
+#define ARQ_ACK_OVERHEAD_RATIO                        8           // window is sized so that waiting for acknowledgement takes at most 1/8 of data airtime
+#define ARQ_TURNAROUND_TIME                           20000       // time to switch between transmission and reception, including processing, in us
+#define ARQ_MAX_RETRIES                               8           // consecutive windows without acknowledgement before the transfer is aborted
+
+/*!
+  \class ARQClient
+
+  \brief Reliable transfer of payloads larger than a single packet over any PhysicalLayer module. Payload is split into fragments,
+  which are sent in windows. Only the last fragment of a window requests acknowledgement, which carries the first missing fragment and a bitmap
+  of the following ones, so that only the missing fragments are retransmitted (selective repeat). Window size is derived from time-on-air.
+  Both sides must use the same fragment size. Session ID starts at random value, so that transfers from a restarted sender are not mistaken
+  for transfers the receiver has already completed.
+*/
+class ARQClient {
+  public:
+    /*!
+      \brief Default constructor.
+
+      \param phy Pointer to the wireless module providing PhysicalLayer communication.
+
+      \param fragmentSize Payload bytes per fragment. Maximum is ARQ_MAX_FRAGMENT_SIZE. Defaults to ARQ_FRAGMENT_SIZE.
+    */
+    ARQClient(PhysicalLayer* phy, uint8_t fragmentSize = ARQ_FRAGMENT_SIZE);
+
+    /*!
+      \brief Sets window size.
+
+      \param window Number of fragments sent before waiting for acknowledgement. Maximum is ARQ_MAX_WINDOW. Set to 0 to derive window size from time-on-air (default).
+    */
+    void setWindowSize(uint8_t window);
+
+    /*!
+      \brief Gets window size that will be used for the next transfer.
+
+      \returns Window size in fragments.
+    */
+    uint8_t getWindowSize();
+
+    /*!
+      \brief Blocking transfer of payload. Returns once all fragments were acknowledged.
+
+      \param data Payload to transfer.
+
+      \param len Length of payload in bytes. Maximum is 65535 fragments.
+
+      \returns \ref status_codes
+    */
+    int16_t send(uint8_t* data, size_t len);
+
+    /*!
+      \brief Blocking reception of payload. Acknowledges received fragments and returns once all fragments were received.
+
+      \param data Pointer to array to save the payload to.
+
+      \param maxLen Size of data array.
+
+      \param len Pointer to variable to save the payload length to.
+
+      \param timeout Maximum time without any received fragment in microseconds. Set to 0 to wait indefinitely.
+
+      \returns \ref status_codes
+    */
+    int16_t receive(uint8_t* data, size_t maxLen, size_t* len, uint32_t timeout = 0);
+
+    /*!
+      \brief Gets number of fragments retransmitted by all transfers sent so far.
+
+      \returns Number of retransmitted fragments.
+    */
+    uint32_t getRetransmissions() const { return(_retransmissions); }
+
+#ifndef RADIOLIB_GODMODE
+  private:
+#endif
+    PhysicalLayer* _phy;
+    uint8_t _fragmentSize;
+    uint8_t _window;
+    uint8_t _session;
+    bool _sessionInit;
+    uint8_t _lastSession;
+    uint16_t _lastNumFragments;
+    bool _lastValid;
+    uint32_t _retransmissions;
+    uint8_t _frame[ARQ_DATA_HEADER_LEN + ARQ_MAX_FRAGMENT_SIZE];
+
+    int16_t waitForAck(uint8_t session, uint16_t numFragments, uint16_t* base, uint32_t* bitmap, uint32_t timeout);
+    int16_t sendAck(uint8_t session, uint16_t numFragments, uint16_t base, uint32_t bitmap);
+};
+
+#endif
@@ -0,0 +1,122 @@
+#include "Aggregator.h"
+
+Aggregator::Aggregator(PhysicalLayer* phy, uint8_t maxFrameLength) {
+  _phy = phy;
+  _maxFrameLength = maxFrameLength;
+  _maxDelay = AGGREGATOR_MAX_DELAY;
+  _overheadTarget = AGGREGATOR_OVERHEAD_TARGET;
+  _len = 0;
+  _count = 0;
+  _firstQueued = 0;
+}
+
+void Aggregator::setFlushPolicy(uint32_t maxDelay, uint8_t overheadTarget) {
+  _maxDelay = maxDelay;
+  _overheadTarget = overheadTarget;
+}
+
+int16_t Aggregator::add(uint8_t* data, size_t len) {
+  // check the message fits into an empty frame
+  size_t prefixLen = (len > 0x7F) ? 2 : 1;
+  if((len == 0) || (prefixLen + len > _maxFrameLength)) {
+    return(ERR_PACKET_TOO_LONG);
+  }
+
+  // send queued messages first if the new one does not fit
+  if(_len + prefixLen + len > _maxFrameLength) {
+    int16_t state = flush();
+    RADIOLIB_ASSERT(state);
+  }
+
+  // length prefix, MSB of the first byte indicates 2-byte length
+  if(prefixLen == 1) {
+    _buffer[_len++] = len;
+  } else {
+    _buffer[_len++] = 0x80 | ((len >> 8) & 0x7F);
+    _buffer[_len++] = len & 0xFF;
+  }
+  memcpy(_buffer + _len, data, len);
+  _len += len;
+
+  if(_count == 0) {
+    _firstQueued = Module::getMicros();
+  }
+  _count++;
+
+  return(update());
+}
+
+int16_t Aggregator::update() {
+  if(_count == 0) {
+    return(ERR_NONE);
+  }
+
+  // oldest message reached maximum delay
+  if(Module::getMicros() - _firstQueued >= _maxDelay) {
+    return(flush());
+  }
+
+  // the smallest message that could still be added does not fit
+  if(_len + 2 > _maxFrameLength) {
+    return(flush());
+  }
+
+  // fixed overhead is the time-on-air of an empty frame
+  if(_overheadTarget > 0) {
+    uint32_t overhead = _phy->getTimeOnAir(0);
+    uint32_t total = _phy->getTimeOnAir(_len);
+    if((uint64_t)overhead * 100 <= (uint64_t)total * _overheadTarget) {
+      return(flush());
+    }
+  }
+
+  return(ERR_NONE);
+}
+
+int16_t Aggregator::flush() {
+  if(_count == 0) {
+    return(ERR_NONE);
+  }
+
+  // messages stay queued if transmission failed
+  int16_t state = _phy->transmit(_buffer, _len);
+  RADIOLIB_ASSERT(state);
+
+  _len = 0;
+  _count = 0;
+  return(ERR_NONE);
+}
+
+int16_t Aggregator::receive(void (*func)(uint8_t* data, size_t len)) {
+  uint8_t frame[AGGREGATOR_MAX_FRAME_LENGTH];
+  int16_t state = _phy->receive(frame, _maxFrameLength);
+  RADIOLIB_ASSERT(state);
+
+  size_t len = _phy->getPacketLength(false);
+  if(len > _maxFrameLength) {
+    len = _maxFrameLength;
+  }
+  return(demultiplex(frame, len, func));
+}
+
+int16_t Aggregator::demultiplex(uint8_t* frame, size_t len, void (*func)(uint8_t* data, size_t len)) {
+  size_t pos = 0;
+  while(pos < len) {
+    // read length prefix
+    size_t msgLen = frame[pos++];
+    if(msgLen & 0x80) {
+      if(pos >= len) {
+        return(ERR_INVALID_FRAME);
+      }
+      msgLen = ((msgLen & 0x7F) << 8) | frame[pos++];
+    }
+
+    // check the message is complete
+    if((msgLen == 0) || (pos + msgLen > len)) {
+      return(ERR_INVALID_FRAME);
+    }
+    func(frame + pos, msgLen);
+    pos += msgLen;
+  }
+  return(ERR_NONE);
+}
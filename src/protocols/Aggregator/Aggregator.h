@@ -0,0 +1,107 @@
+#ifndef _RADIOLIB_AGGREGATOR_H
+#define _RADIOLIB_AGGREGATOR_H
+
+#include "../../TypeDef.h"
+#include "../../Module.h"
+#include "../PhysicalLayer/PhysicalLayer.h"
+
+#define AGGREGATOR_MAX_FRAME_LENGTH                   255
+#define AGGREGATOR_MAX_DELAY                          10000000    // default maximum time a message may wait in queue in us
+#define AGGREGATOR_OVERHEAD_TARGET                    20          // default share of fixed frame overhead in airtime at which the frame is sent, in %
+
+/*!
+  \class Aggregator
+
+  \brief Packs multiple short messages into a single frame to amortize fixed preamble and header airtime.
+  Each message is prefixed by its length (1 byte up to 127 bytes, 2 bytes otherwise). Frame is sent when the next message does not fit,
+  when the oldest message reaches maximum delay, or once the fixed frame overhead drops below the target share of time-on-air.
+*/
+class Aggregator {
+  public:
+    /*!
+      \brief Default constructor.
+
+      \param phy Pointer to the wireless module providing PhysicalLayer communication.
+
+      \param maxFrameLength Maximum length of aggregated frame in bytes. Defaults to AGGREGATOR_MAX_FRAME_LENGTH.
+    */
+    Aggregator(PhysicalLayer* phy, uint8_t maxFrameLength = AGGREGATOR_MAX_FRAME_LENGTH);
+
+    /*!
+      \brief Sets flush policy.
+
+      \param maxDelay Maximum time the oldest message may wait in queue in microseconds. Defaults to AGGREGATOR_MAX_DELAY.
+
+      \param overheadTarget Frame is sent once the fixed overhead (preamble, header) takes at most this share of time-on-air, in %.
+      Set to 0 to only send full frames. Defaults to AGGREGATOR_OVERHEAD_TARGET.
+    */
+    void setFlushPolicy(uint32_t maxDelay = AGGREGATOR_MAX_DELAY, uint8_t overheadTarget = AGGREGATOR_OVERHEAD_TARGET);
+
+    /*!
+      \brief Queues message for transmission. Queued messages are sent first if the new one does not fit.
+
+      \param data Message to queue.
+
+      \param len Length of message in bytes.
+
+      \returns \ref status_codes
+    */
+    int16_t add(uint8_t* data, size_t len);
+
+    /*!
+      \brief Sends queued messages if flush policy requires it. Should be called periodically.
+
+      \returns \ref status_codes
+    */
+    int16_t update();
+
+    /*!
+      \brief Sends all queued messages immediately.
+
+      \returns \ref status_codes
+    */
+    int16_t flush();
+
+    /*!
+      \brief Gets number of queued messages.
+
+      \returns Number of messages waiting for transmission.
+    */
+    uint8_t getQueued() const { return(_count); }
+
+    /*!
+      \brief Receives aggregated frame and passes each message to the callback.
+
+      \param func Function called for each received message.
+
+      \returns \ref status_codes
+    */
+    int16_t receive(void (*func)(uint8_t* data, size_t len));
+
+    /*!
+      \brief Splits aggregated frame into messages and passes each one to the callback.
+
+      \param frame Aggregated frame.
+
+      \param len Length of the frame in bytes.
+
+      \param func Function called for each message.
+
+      \returns \ref status_codes
+    */
+    static int16_t demultiplex(uint8_t* frame, size_t len, void (*func)(uint8_t* data, size_t len));
+
+#ifndef RADIOLIB_GODMODE
+  private:
+#endif
+    PhysicalLayer* _phy;
+    uint8_t _maxFrameLength;
+    uint32_t _maxDelay;
+    uint8_t _overheadTarget;
+    uint8_t _buffer[AGGREGATOR_MAX_FRAME_LENGTH];
+    size_t _len;
+    uint8_t _count;
+    uint32_t _firstQueued;
+};
+
+#endif
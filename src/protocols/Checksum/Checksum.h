@@ -0,0 +1,143 @@
+#ifndef _RADIOLIB_CHECKSUM_H
+#define _RADIOLIB_CHECKSUM_H
+
+#include "../../TypeDef.h"
+
+// lookup table size: slice-by-8 (8 x 256 entries, 8 kB per instance) on Linux, nibble table (16 entries) elsewhere
+// define CHECKSUM_SLICE_BY_8 to use slice-by-8 on microcontrollers with enough RAM
+#ifndef CHECKSUM_SLICE_BY_8
+  #if defined(LINUX)
+    #define CHECKSUM_SLICE_BY_8
+  #endif
+#endif
+
+// period of PN9 whitening sequence in bytes
+#define CHECKSUM_PN9_PERIOD                           511
+
+/*!
+  \struct ChecksumAlgorithm
+
+  \brief Parameters of CRC algorithm, using the usual Rocksoft model.
+*/
+struct ChecksumAlgorithm {
+  /*!
+    \brief CRC width in bits, 8 to 32.
+  */
+  uint8_t width;
+
+  /*!
+    \brief Generator polynomial in normal (MSB-first) notation, without the highest term.
+  */
+  uint32_t poly;
+
+  /*!
+    \brief Initial value of CRC register.
+  */
+  uint32_t init;
+
+  /*!
+    \brief Value XORed with CRC register to get the result.
+  */
+  uint32_t xorOut;
+
+  /*!
+    \brief Whether bytes are processed LSB first.
+  */
+  bool reflected;
+};
+
+/*!
+  \brief CRC-16 CCITT as calculated by SX127x in FSK mode (SX127X_CRC_WHITENING_TYPE_CCITT).
+*/
+extern const ChecksumAlgorithm ChecksumCRC16CCITT;
+
+/*!
+  \brief CRC-16 IBM as calculated by SX127x in FSK mode (SX127X_CRC_WHITENING_TYPE_IBM).
+*/
+extern const ChecksumAlgorithm ChecksumCRC16IBM;
+
+/*!
+  \brief CRC-32 (IEEE 802.3).
+*/
+extern const ChecksumAlgorithm ChecksumCRC32;
+
+/*!
+  \class Checksum
+
+  \brief Table-driven CRC calculation for frames verified in software, e.g. in direct mode or across aggregated frames and fragments.
+  Lookup tables are built once in constructor, so a single instance should be reused. Processing is done 8 bytes at a time (slice-by-8)
+  on Linux, and one nibble at a time on microcontrollers unless CHECKSUM_SLICE_BY_8 is defined. On AArch64, CRC-32 uses hardware instructions when enabled by compiler flags.
+*/
+class Checksum {
+  public:
+    /*!
+      \brief Default constructor.
+
+      \param algorithm CRC algorithm to use. Defaults to ChecksumCRC32.
+    */
+    Checksum(const ChecksumAlgorithm& algorithm = ChecksumCRC32);
+
+    /*!
+      \brief Calculates CRC of a single buffer.
+
+      \param data Data to calculate CRC of.
+
+      \param len Length of data in bytes.
+
+      \returns CRC value.
+    */
+    uint32_t calculate(const uint8_t* data, size_t len);
+
+    /*!
+      \brief Resets CRC register to initial value, to start incremental calculation.
+    */
+    void reset();
+
+    /*!
+      \brief Adds data to incremental calculation.
+
+      \param data Data to add.
+
+      \param len Length of data in bytes.
+    */
+    void update(const uint8_t* data, size_t len);
+
+    /*!
+      \brief Gets result of incremental calculation.
+
+      \returns CRC value of all data added since the last reset.
+    */
+    uint32_t getValue();
+
+    /*!
+      \brief Applies PN9 data whitening (x^9 + x^5 + 1, seed 0x1FF) used by SX127x in FSK mode (SX127X_DC_FREE_WHITENING).
+      Whitening is its own inverse, so the same call is used to remove it.
+
+      \param data Data to whiten in place.
+
+      \param len Length of data in bytes.
+
+      \param pos Position within the whitening sequence, i.e. number of bytes already processed in this packet. Defaults to 0.
+
+      \returns Position for the next call, in case packet is processed in parts.
+    */
+    static uint16_t whiten(uint8_t* data, size_t len, uint16_t pos = 0);
+
+#ifndef RADIOLIB_GODMODE
+  private:
+#endif
+    ChecksumAlgorithm _algorithm;
+    uint32_t _crc;
+    bool _hardware;
+
+#if defined(CHECKSUM_SLICE_BY_8)
+    uint32_t _table[8][256];
+#else
+    uint32_t _table[16];
+#endif
+
+    uint32_t process(uint32_t crc, const uint8_t* data, size_t len);
+    static uint32_t reflect(uint32_t value, uint8_t width);
+};
+
+#endif
@@ -0,0 +1,274 @@
+#include "Compressor.h"
+
+Compressor::Compressor(PhysicalLayer* phy, uint8_t maxFrameLength) {
+  _phy = phy;
+  _maxFrameLength = maxFrameLength;
+  _delta = false;
+  _keyframeInterval = COMPRESSOR_KEYFRAME_INTERVAL;
+  _txNext = 0;
+  _rxNext = 0;
+  for(uint8_t i = 0; i < COMPRESSOR_MAX_PEERS; i++) {
+    _txDict[i].used = false;
+    _txDict[i].frames = 0;
+    _txDict[i].len = 0;
+    _rxDict[i].used = false;
+    _rxDict[i].frames = 0;
+    _rxDict[i].len = 0;
+  }
+}
+
+void Compressor::setDeltaMode(bool enable) {
+  _delta = enable;
+}
+
+void Compressor::setKeyframeInterval(uint8_t interval) {
+  _keyframeInterval = interval;
+}
+
+int16_t Compressor::transmit(uint8_t* data, size_t len, uint32_t peer) {
+  size_t frameLen = 0;
+
+  // compressed payload is only used when it is shorter than the original
+  size_t limit = (len < (size_t)_maxFrameLength) ? len : _maxFrameLength;
+
+  // try previous frame as dictionary first, unless keyframe is due
+  CompressorDict* dict = NULL;
+  if(_delta) {
+    dict = findDict(_txDict, &_txNext, peer);
+    bool keyframe = (_keyframeInterval > 0) && (dict->frames >= _keyframeInterval);
+    if(!keyframe && (dict->len > 0) && (limit > COMPRESSOR_DELTA_HEADER_LENGTH)) {
+      frameLen = compress(data, len, _frame + COMPRESSOR_DELTA_HEADER_LENGTH, limit - COMPRESSOR_DELTA_HEADER_LENGTH, dict->data, dict->len);
+      if(frameLen > 0) {
+        uint16_t crc = checksum(dict->data, dict->len);
+        _frame[0] = COMPRESSOR_MODE_DELTA;
+        _frame[1] = (crc >> 8) & 0xFF;
+        _frame[2] = crc & 0xFF;
+        frameLen += COMPRESSOR_DELTA_HEADER_LENGTH;
+      }
+    }
+  }
+
+  // plain compression
+  if((frameLen == 0) && (limit > 1)) {
+    frameLen = compress(data, len, _frame + 1, limit - 1);
+    if(frameLen > 0) {
+      _frame[0] = COMPRESSOR_MODE_LZ;
+      frameLen += 1;
+    }
+  }
+
+  // incompressible data is sent unchanged
+  if(frameLen == 0) {
+    if(len + 1 > _maxFrameLength) {
+      return(ERR_PACKET_TOO_LONG);
+    }
+    _frame[0] = COMPRESSOR_MODE_RAW;
+    memcpy(_frame + 1, data, len);
+    frameLen = len + 1;
+  }
+
+  int16_t state = _phy->transmit(_frame, frameLen);
+  RADIOLIB_ASSERT(state);
+
+  // the next frame to this peer can use this one as dictionary
+  if(dict != NULL) {
+    dict->frames = (_frame[0] == COMPRESSOR_MODE_DELTA) ? dict->frames + 1 : 0;
+    updateDict(dict, data, len);
+  }
+  return(ERR_NONE);
+}
+
+int16_t Compressor::receive(uint8_t* data, size_t maxLen, size_t* len, uint32_t peer) {
+  int16_t state = _phy->receive(_frame, _maxFrameLength);
+  RADIOLIB_ASSERT(state);
+  return(decode(_phy->getPacketLength(false), data, maxLen, len, peer));
+}
+
+int16_t Compressor::readData(uint8_t* data, size_t maxLen, size_t* len, uint32_t peer) {
+  int16_t state = _phy->readData(_frame, _maxFrameLength);
+  RADIOLIB_ASSERT(state);
+  return(decode(_phy->getPacketLength(false), data, maxLen, len, peer));
+}
+
+int16_t Compressor::decode(size_t frameLen, uint8_t* data, size_t maxLen, size_t* len, uint32_t peer) {
+  if((frameLen == 0) || (frameLen > _maxFrameLength)) {
+    return(ERR_INVALID_FRAME);
+  }
+
+  size_t outLen = 0;
+  CompressorDict* dict = findDict(_rxDict, &_rxNext, peer);
+  switch(_frame[0]) {
+    case COMPRESSOR_MODE_RAW:
+      outLen = frameLen - 1;
+      if(outLen > maxLen) {
+        return(ERR_PACKET_TOO_LONG);
+      }
+      memcpy(data, _frame + 1, outLen);
+      break;
+
+    case COMPRESSOR_MODE_LZ:
+      outLen = decompress(_frame + 1, frameLen - 1, data, maxLen);
+      if(outLen == 0) {
+        return(ERR_INVALID_FRAME);
+      }
+      break;
+
+    case COMPRESSOR_MODE_DELTA:
+      // both sides must have the same previous frame, otherwise wait for the next keyframe
+      if((frameLen < COMPRESSOR_DELTA_HEADER_LENGTH) || (dict->len == 0) ||
+         ((((uint16_t)_frame[1] << 8) | _frame[2]) != checksum(dict->data, dict->len))) {
+        return(ERR_DICTIONARY_MISMATCH);
+      }
+      outLen = decompress(_frame + COMPRESSOR_DELTA_HEADER_LENGTH, frameLen - COMPRESSOR_DELTA_HEADER_LENGTH, data, maxLen, dict->data, dict->len);
+      if(outLen == 0) {
+        return(ERR_INVALID_FRAME);
+      }
+      break;
+
+    default:
+      return(ERR_INVALID_FRAME);
+  }
+
+  updateDict(dict, data, outLen);
+  *len = outLen;
+  return(ERR_NONE);
+}
+
+size_t Compressor::compress(const uint8_t* in, size_t inLen, uint8_t* out, size_t outMax, const uint8_t* dict, size_t dictLen) {
+  size_t outPos = 0;
+  size_t flagPos = 0;
+  uint8_t flagBit = 8;
+
+  // positions are counted over dictionary followed by input
+  size_t pos = 0;
+  while(pos < inLen) {
+    // every 8 items are preceded by flag byte, bit set means match
+    if(flagBit == 8) {
+      if(outPos >= outMax) {
+        return(0);
+      }
+      flagPos = outPos;
+      out[outPos++] = 0x00;
+      flagBit = 0;
+    }
+
+    // find the longest match in window
+    size_t cur = dictLen + pos;
+    size_t start = (cur > COMPRESSOR_MAX_OFFSET) ? (cur - COMPRESSOR_MAX_OFFSET) : 0;
+    size_t bestLen = 0;
+    size_t bestOffset = 0;
+    for(size_t cand = start; cand < cur; cand++) {
+      size_t matchLen = 0;
+      while((matchLen < COMPRESSOR_MAX_MATCH) && (pos + matchLen < inLen)) {
+        size_t src = cand + matchLen;
+        uint8_t b = (src < dictLen) ? dict[src] : in[src - dictLen];
+        if(b != in[pos + matchLen]) {
+          break;
+        }
+        matchLen++;
+      }
+      if(matchLen > bestLen) {
+        bestLen = matchLen;
+        bestOffset = cur - cand;
+        if(bestLen == COMPRESSOR_MAX_MATCH) {
+          break;
+        }
+      }
+    }
+
+    if(bestLen >= COMPRESSOR_MIN_MATCH) {
+      // match: 12-bit offset and 4-bit length
+      if(outPos + 2 > outMax) {
+        return(0);
+      }
+      out[flagPos] |= (1 << flagBit);
+      out[outPos++] = ((bestOffset - 1) >> 4) & 0xFF;
+      out[outPos++] = (((bestOffset - 1) & 0x0F) << 4) | (bestLen - COMPRESSOR_MIN_MATCH);
+      pos += bestLen;
+    } else {
+      // literal
+      if(outPos + 1 > outMax) {
+        return(0);
+      }
+      out[outPos++] = in[pos++];
+    }
+    flagBit++;
+  }
+
+  return(outPos);
+}
+
+size_t Compressor::decompress(const uint8_t* in, size_t inLen, uint8_t* out, size_t outMax, const uint8_t* dict, size_t dictLen) {
+  size_t inPos = 0;
+  size_t outPos = 0;
+  while(inPos < inLen) {
+    uint8_t flags = in[inPos++];
+    for(uint8_t bit = 0; (bit < 8) && (inPos < inLen); bit++) {
+      if(flags & (1 << bit)) {
+        // match
+        if(inPos + 2 > inLen) {
+          return(0);
+        }
+        size_t offset = (((size_t)in[inPos] << 4) | (in[inPos + 1] >> 4)) + 1;
+        size_t matchLen = (in[inPos + 1] & 0x0F) + COMPRESSOR_MIN_MATCH;
+        inPos += 2;
+        if((offset > dictLen + outPos) || (outPos + matchLen > outMax)) {
+          return(0);
+        }
+
+        // copy byte by byte, source may overlap the output
+        size_t src = dictLen + outPos - offset;
+        for(size_t i = 0; i < matchLen; i++) {
+          out[outPos++] = (src + i < dictLen) ? dict[src + i] : out[src + i - dictLen];
+        }
+      } else {
+        // literal
+        if(outPos >= outMax) {
+          return(0);
+        }
+        out[outPos++] = in[inPos++];
+      }
+    }
+  }
+
+  return(outPos);
+}
+
+Compressor::CompressorDict* Compressor::findDict(CompressorDict* dicts, uint8_t* next, uint32_t peer) {
+  for(uint8_t i = 0; i < COMPRESSOR_MAX_PEERS; i++) {
+    if(dicts[i].used && (dicts[i].peer == peer)) {
+      return(&dicts[i]);
+    }
+  }
+
+  // replace slots in round-robin order
+  CompressorDict* dict = &dicts[*next];
+  *next = (*next + 1) % COMPRESSOR_MAX_PEERS;
+  dict->peer = peer;
+  dict->used = true;
+  dict->frames = 0;
+  dict->len = 0;
+  return(dict);
+}
+
+void Compressor::updateDict(CompressorDict* dict, const uint8_t* data, size_t len) {
+  // keep the end of the frame, it is closest to the next one
+  if(len > COMPRESSOR_DICT_SIZE) {
+    data += len - COMPRESSOR_DICT_SIZE;
+    len = COMPRESSOR_DICT_SIZE;
+  }
+  memcpy(dict->data, data, len);
+  dict->len = len;
+}
+
+uint16_t Compressor::checksum(const uint8_t* data, size_t len) {
+  // CRC-16 CCITT, computed bitwise since dictionary is short and checked once per frame
+  uint16_t crc = 0xFFFF;
+  for(size_t i = 0; i < len; i++) {
+    crc ^= (uint16_t)data[i] << 8;
+    for(uint8_t j = 0; j < 8; j++) {
+      crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+  }
+  return(crc);
+}
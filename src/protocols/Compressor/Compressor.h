@@ -0,0 +1,185 @@
+#ifndef _RADIOLIB_COMPRESSOR_H
+#define _RADIOLIB_COMPRESSOR_H
+
+#include "../../TypeDef.h"
+#include "../PhysicalLayer/PhysicalLayer.h"
+
+// frame header
+#define COMPRESSOR_MODE_RAW                           0x00        // payload is not compressed
+#define COMPRESSOR_MODE_LZ                            0x01        // payload is LZSS compressed
+#define COMPRESSOR_MODE_DELTA                         0x02        // payload is LZSS compressed using previous frame as dictionary, followed by CRC-16 of the dictionary
+
+// LZSS parameters, match is encoded in 2 bytes as 12-bit offset and 4-bit length
+#define COMPRESSOR_MIN_MATCH                          3
+#define COMPRESSOR_MAX_MATCH                          18
+#define COMPRESSOR_MAX_OFFSET                         4096
+
+#define COMPRESSOR_MAX_FRAME_LENGTH                   255
+
+// delta frame header: mode and CRC-16 CCITT of the dictionary
+#define COMPRESSOR_DELTA_HEADER_LENGTH                3
+
+// delta frames sent before the next frame is forced to be compressed without dictionary
+#define COMPRESSOR_KEYFRAME_INTERVAL                  8
+
+// previous frames kept for delta mode
+#ifndef COMPRESSOR_DICT_SIZE
+  #if defined(__AVR__)
+    #define COMPRESSOR_DICT_SIZE                      64
+  #else
+    #define COMPRESSOR_DICT_SIZE                      255
+  #endif
+#endif
+
+#ifndef COMPRESSOR_MAX_PEERS
+  #if defined(__AVR__)
+    #define COMPRESSOR_MAX_PEERS                      1
+  #else
+    #define COMPRESSOR_MAX_PEERS                      4
+  #endif
+#endif
+
+/*!
+  \class Compressor
+
+  \brief Optional compression stage for PhysicalLayer transmission and reception. Payload is compressed by small-window LZSS codec
+  that works on the frame in place, so that no extra window buffer is needed. In delta mode, the previous frame exchanged with the same peer
+  is used as dictionary, which suits repeated sensor frames. Delta mode requires both sides to see the same frames. Delta frames received with
+  a different dictionary are rejected, and both sides get back in sync on the next keyframe, i.e. frame compressed without dictionary,
+  which is forced periodically. Data that does not compress is sent unchanged with a 1-byte header.
+*/
+class Compressor {
+  public:
+    /*!
+      \brief Default constructor.
+
+      \param phy Pointer to the wireless module providing PhysicalLayer communication.
+
+      \param maxFrameLength Maximum length of transmitted frame in bytes, e.g. 63 for FSK without streaming. Defaults to COMPRESSOR_MAX_FRAME_LENGTH.
+    */
+    Compressor(PhysicalLayer* phy, uint8_t maxFrameLength = COMPRESSOR_MAX_FRAME_LENGTH);
+
+    /*!
+      \brief Enables or disables delta mode for transmission. Reception of delta frames is always supported.
+
+      \param enable Whether to use previous frame to the same peer as dictionary.
+    */
+    void setDeltaMode(bool enable);
+
+    /*!
+      \brief Sets how often keyframes are sent in delta mode, so that receiver that lost a frame can recover.
+
+      \param interval Number of delta frames to the same peer after which the next frame is sent without dictionary.
+      Set to 0 to only send keyframes when delta compression does not help. Defaults to COMPRESSOR_KEYFRAME_INTERVAL.
+    */
+    void setKeyframeInterval(uint8_t interval);
+
+    /*!
+      \brief Compresses and transmits payload.
+
+      \param data Payload to transmit. May be longer than maximum frame length, as long as it compresses enough.
+
+      \param len Length of payload in bytes.
+
+      \param peer Identifier of the link, used to select delta dictionary. Defaults to 0.
+
+      \returns \ref status_codes
+    */
+    int16_t transmit(uint8_t* data, size_t len, uint32_t peer = 0);
+
+    /*!
+      \brief Receives and decompresses payload.
+
+      \param data Pointer to array to save the payload to.
+
+      \param maxLen Size of data array.
+
+      \param len Pointer to variable to save the payload length to.
+
+      \param peer Identifier of the link, used to select delta dictionary. Defaults to 0.
+
+      \returns \ref status_codes
+    */
+    int16_t receive(uint8_t* data, size_t maxLen, size_t* len, uint32_t peer = 0);
+
+    /*!
+      \brief Reads and decompresses payload after interrupt-driven reception.
+
+      \param data Pointer to array to save the payload to.
+
+      \param maxLen Size of data array.
+
+      \param len Pointer to variable to save the payload length to.
+
+      \param peer Identifier of the link, used to select delta dictionary. Defaults to 0.
+
+      \returns \ref status_codes
+    */
+    int16_t readData(uint8_t* data, size_t maxLen, size_t* len, uint32_t peer = 0);
+
+    /*!
+      \brief LZSS compression.
+
+      \param in Data to compress.
+
+      \param inLen Length of data in bytes.
+
+      \param out Pointer to array to save the compressed data to.
+
+      \param outMax Size of out array.
+
+      \param dict Dictionary, i.e. data that precedes the input on both sides. Can be NULL.
+
+      \param dictLen Length of dictionary in bytes.
+
+      \returns Length of compressed data, or 0 if it does not fit into out array.
+    */
+    static size_t compress(const uint8_t* in, size_t inLen, uint8_t* out, size_t outMax, const uint8_t* dict = NULL, size_t dictLen = 0);
+
+    /*!
+      \brief LZSS decompression.
+
+      \param in Compressed data.
+
+      \param inLen Length of compressed data in bytes.
+
+      \param out Pointer to array to save the decompressed data to.
+
+      \param outMax Size of out array.
+
+      \param dict Dictionary used for compression. Can be NULL.
+
+      \param dictLen Length of dictionary in bytes.
+
+      \returns Length of decompressed data, or 0 if the data is invalid or does not fit into out array.
+    */
+    static size_t decompress(const uint8_t* in, size_t inLen, uint8_t* out, size_t outMax, const uint8_t* dict = NULL, size_t dictLen = 0);
+
+#ifndef RADIOLIB_GODMODE
+  private:
+#endif
+    struct CompressorDict {
+      uint32_t peer;
+      bool used;
+      uint8_t frames;
+      uint8_t len;
+      uint8_t data[COMPRESSOR_DICT_SIZE];
+    };
+
+    PhysicalLayer* _phy;
+    uint8_t _maxFrameLength;
+    bool _delta;
+    uint8_t _keyframeInterval;
+    uint8_t _frame[COMPRESSOR_MAX_FRAME_LENGTH];
+    CompressorDict _txDict[COMPRESSOR_MAX_PEERS];
+    CompressorDict _rxDict[COMPRESSOR_MAX_PEERS];
+    uint8_t _txNext;
+    uint8_t _rxNext;
+
+    int16_t decode(size_t frameLen, uint8_t* data, size_t maxLen, size_t* len, uint32_t peer);
+    static CompressorDict* findDict(CompressorDict* dicts, uint8_t* next, uint32_t peer);
+    static void updateDict(CompressorDict* dict, const uint8_t* data, size_t len);
+    static uint16_t checksum(const uint8_t* data, size_t len);
+};
+
+#endif
@@ -0,0 +1,131 @@
+#include "DedupCache.h"
+
+DedupCache::DedupCache(uint32_t window) {
+  _window = window;
+  _duplicates = 0;
+  clear();
+}
+
+void DedupCache::setWindow(uint32_t window) {
+  _window = window;
+}
+
+uint8_t DedupCache::check(const uint8_t* data, size_t len, float rssi, float snr, uint8_t radio) {
+  uint32_t now = Module::getMicros();
+  uint32_t h = hash(data, len);
+
+  // duplicate, update the best copy
+  DedupEntry* entry = find(h, len, now);
+  if(entry != NULL) {
+    _duplicates++;
+    if(entry->count < 0xFF) {
+      entry->count++;
+    }
+    if((snr > entry->snr) || ((snr == entry->snr) && (rssi > entry->rssi))) {
+      entry->rssi = rssi;
+      entry->snr = snr;
+      entry->radio = radio;
+      return(DEDUP_BETTER);
+    }
+    return(DEDUP_DUPLICATE);
+  }
+
+  // new packet, take the first free or expired slot, or replace the oldest one
+  uint32_t home = h & (DEDUP_CACHE_SIZE - 1);
+  DedupEntry* slot = NULL;
+  uint32_t oldest = 0;
+  for(uint8_t i = 0; i < DEDUP_CACHE_MAX_PROBE; i++) {
+    DedupEntry* e = &_entries[(home + i) & (DEDUP_CACHE_SIZE - 1)];
+    uint32_t age = now - e->timestamp;
+    if(!e->used || (age > _window)) {
+      slot = e;
+      break;
+    }
+    if((slot == NULL) || (age > oldest)) {
+      slot = e;
+      oldest = age;
+    }
+  }
+
+  slot->hash = h;
+  slot->timestamp = now;
+  slot->len = len;
+  slot->count = 1;
+  slot->radio = radio;
+  slot->rssi = rssi;
+  slot->snr = snr;
+  slot->used = true;
+  return(DEDUP_NEW);
+}
+
+bool DedupCache::getBest(const uint8_t* data, size_t len, DedupEntry* entry) {
+  DedupEntry* e = find(hash(data, len), len, Module::getMicros());
+  if(e == NULL) {
+    return(false);
+  }
+  memcpy(entry, e, sizeof(DedupEntry));
+  return(true);
+}
+
+void DedupCache::clear() {
+  for(uint32_t i = 0; i < DEDUP_CACHE_SIZE; i++) {
+    _entries[i].used = false;
+  }
+}
+
+uint32_t DedupCache::getDuplicates() {
+  return(_duplicates);
+}
+
+uint32_t DedupCache::hash(const uint8_t* data, size_t len) {
+  // MurmurHash3 x86_32 with zero seed, blocks are read as little endian regardless of platform
+  uint32_t h = 0;
+  size_t i = 0;
+  for(; i + 4 <= len; i += 4) {
+    uint32_t k = (uint32_t)data[i] | ((uint32_t)data[i + 1] << 8) | ((uint32_t)data[i + 2] << 16) | ((uint32_t)data[i + 3] << 24);
+    k *= 0xCC9E2D51;
+    k = (k << 15) | (k >> 17);
+    k *= 0x1B873593;
+    h ^= k;
+    h = (h << 13) | (h >> 19);
+    h = h * 5 + 0xE6546B64;
+  }
+
+  // remaining 1 - 3 bytes
+  uint32_t k = 0;
+  switch(len & 3) {
+    case 3:
+      k ^= (uint32_t)data[i + 2] << 16;
+      // fall through
+    case 2:
+      k ^= (uint32_t)data[i + 1] << 8;
+      // fall through
+    case 1:
+      k ^= data[i];
+      k *= 0xCC9E2D51;
+      k = (k << 15) | (k >> 17);
+      k *= 0x1B873593;
+      h ^= k;
+  }
+
+  // finalization mix
+  h ^= len;
+  h ^= h >> 16;
+  h *= 0x85EBCA6B;
+  h ^= h >> 13;
+  h *= 0xC2B2AE35;
+  h ^= h >> 16;
+  return(h);
+}
+
+DedupEntry* DedupCache::find(uint32_t hash, uint16_t len, uint32_t now) {
+  // entries are not moved on expiry, so all probed slots have to be checked
+  uint32_t home = hash & (DEDUP_CACHE_SIZE - 1);
+  for(uint8_t i = 0; i < DEDUP_CACHE_MAX_PROBE; i++) {
+    DedupEntry* e = &_entries[(home + i) & (DEDUP_CACHE_SIZE - 1)];
+    if(e->used && (e->hash == hash) && (e->len == len) && (now - e->timestamp <= _window)) {
+      return(e);
+    }
+  }
+  return(NULL);
+}
@@ -0,0 +1,168 @@
+#ifndef _RADIOLIB_DEDUP_CACHE_H
+#define _RADIOLIB_DEDUP_CACHE_H
+
+#include "../../TypeDef.h"
+#include "../../Module.h"
+
+// number of cache slots, must be power of 2, large cache is only used on Linux gateways
+#ifndef DEDUP_CACHE_SIZE
+  #if defined(LINUX)
+    #define DEDUP_CACHE_SIZE                          1024
+  #elif defined(__AVR__)
+    #define DEDUP_CACHE_SIZE                          16
+  #else
+    #define DEDUP_CACHE_SIZE                          64
+  #endif
+#endif
+
+// number of slots searched from the home slot, when all of them are live the oldest one is replaced
+#ifndef DEDUP_CACHE_MAX_PROBE
+  #if defined(__AVR__)
+    #define DEDUP_CACHE_MAX_PROBE                     4
+  #else
+    #define DEDUP_CACHE_MAX_PROBE                     8
+  #endif
+#endif
+
+#define DEDUP_CACHE_WINDOW                            1000000     // default duplicate window in us
+
+// results of DedupCache::check
+#define DEDUP_NEW                                     0           // first copy of the packet
+#define DEDUP_BETTER                                  1           // duplicate received with better quality than all previous copies
+#define DEDUP_DUPLICATE                               2           // duplicate, not better than the best copy
+
+/*!
+  \struct DedupEntry
+
+  \brief Packet tracked by DedupCache, together with the best copy received so far.
+*/
+struct DedupEntry {
+  /*!
+    \brief Payload hash.
+  */
+  uint32_t hash;
+
+  /*!
+    \brief Timestamp of the first copy in microseconds.
+  */
+  uint32_t timestamp;
+
+  /*!
+    \brief Payload length in bytes.
+  */
+  uint16_t len;
+
+  /*!
+    \brief Number of copies received.
+  */
+  uint8_t count;
+
+  /*!
+    \brief Radio that received the best copy.
+  */
+  uint8_t radio;
+
+  /*!
+    \brief RSSI of the best copy in dBm.
+  */
+  float rssi;
+
+  /*!
+    \brief SNR of the best copy in dB.
+  */
+  float snr;
+
+  /*!
+    \brief Whether the slot holds a packet.
+  */
+  bool used;
+};
+
+/*!
+  \class DedupCache
+
+  \brief Duplicate packet suppression for gateways with multiple radios or antennas. Packets are identified by payload hash and length,
+  copies received within the duplicate window of the first copy are duplicates. Entries are kept in a fixed-size open addressing table
+  with bounded linear probing, so both lookup and insertion take constant time and no memory is allocated. Expired entries are reused in place.
+  Best copy is the one with the highest SNR, or the highest RSSI when SNR is equal. Not thread-safe, calls from multiple receive threads must be serialized.
+*/
+class DedupCache {
+  public:
+    /*!
+      \brief Default constructor.
+
+      \param window Duplicate window in microseconds. Defaults to DEDUP_CACHE_WINDOW.
+    */
+    DedupCache(uint32_t window = DEDUP_CACHE_WINDOW);
+
+    /*!
+      \brief Sets duplicate window.
+
+      \param window Duplicate window in microseconds.
+    */
+    void setWindow(uint32_t window);
+
+    /*!
+      \brief Checks received packet against the cache and records it.
+
+      \param data Received payload.
+
+      \param len Length of payload in bytes.
+
+      \param rssi RSSI of the packet in dBm.
+
+      \param snr SNR of the packet in dB.
+
+      \param radio Index of the radio that received the packet. Defaults to 0.
+
+      \returns DEDUP_NEW for the first copy, DEDUP_BETTER for duplicate that is the best copy so far, DEDUP_DUPLICATE otherwise.
+    */
+    uint8_t check(const uint8_t* data, size_t len, float rssi, float snr, uint8_t radio = 0);
+
+    /*!
+      \brief Gets the best copy of packet received within the duplicate window.
+
+      \param data Payload of the packet.
+
+      \param len Length of payload in bytes.
+
+      \param entry Pointer to variable to save the cache entry to.
+
+      \returns Whether the packet was found in the cache.
+    */
+    bool getBest(const uint8_t* data, size_t len, DedupEntry* entry);
+
+    /*!
+      \brief Removes all entries.
+    */
+    void clear();
+
+    /*!
+      \brief Gets number of duplicates detected since construction.
+
+      \returns Number of duplicates.
+    */
+    uint32_t getDuplicates();
+
+    /*!
+      \brief Fast 32-bit payload hash (MurmurHash3), also usable to identify packets elsewhere.
+
+      \param data Data to hash.
+
+      \param len Length of data in bytes.
+
+      \returns Hash value.
+    */
+    static uint32_t hash(const uint8_t* data, size_t len);
+
+#ifndef RADIOLIB_GODMODE
+  private:
+#endif
+    DedupEntry _entries[DEDUP_CACHE_SIZE];
+    uint32_t _window;
+    uint32_t _duplicates;
+
+    DedupEntry* find(uint32_t hash, uint16_t len, uint32_t now);
+};
+
+#endif
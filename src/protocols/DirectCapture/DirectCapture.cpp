@@ -0,0 +1,160 @@
+#include "DirectCapture.h"
+
+#ifdef LINUX
+
+DirectCapture::DirectCapture(PhysicalLayer* phy) : _running(false), _head(0), _tail(0), _overflows(0), _clockDropped(0) {
+  _phy = phy;
+  _bitByte = 0;
+  _bitPos = 8;
+  _bitTimestamp = 0;
+}
+
+DirectCapture::~DirectCapture() {
+  end();
+}
+
+int16_t DirectCapture::begin(const char* chip, uint32_t clkLine, uint32_t dataLine) {
+  // stop previous capture
+  end();
+
+  // clock is sampled on rising edge only, data level is tracked from both edges
+  uint32_t offsets[] = { clkLine, dataLine };
+  uint8_t edges[] = { RISING, CHANGE };
+  int16_t state = _gpio.begin(chip, offsets, edges, 2);
+  RADIOLIB_ASSERT(state);
+
+  // enable direct receive mode
+  state = _phy->receiveDirect();
+  if(state != ERR_NONE) {
+    _gpio.end();
+    return(state);
+  }
+
+  // reset buffer and start capture thread
+  _head.store(0);
+  _tail.store(0);
+  _overflows.store(0);
+  _clockDropped.store(0);
+  _bitPos = 8;
+  _running.store(true);
+  _thread = std::thread(&DirectCapture::captureLoop, this);
+
+  return(ERR_NONE);
+}
+
+void DirectCapture::end() {
+  _running.store(false);
+  if(_thread.joinable()) {
+    _thread.join();
+  }
+  _gpio.end();
+}
+
+size_t DirectCapture::available() const {
+  return(_head.load(std::memory_order_acquire) - _tail.load(std::memory_order_relaxed));
+}
+
+size_t DirectCapture::read(uint8_t* data, size_t len, uint64_t* timestamps) {
+  uint32_t tail = _tail.load(std::memory_order_relaxed);
+  uint32_t head = _head.load(std::memory_order_acquire);
+
+  // copy out available bytes
+  size_t num = head - tail;
+  if(num > len) {
+    num = len;
+  }
+  for(size_t i = 0; i < num; i++) {
+    uint32_t pos = (tail + i) & (DIRECT_CAPTURE_RING_SIZE - 1);
+    data[i] = _data[pos];
+    if(timestamps != NULL) {
+      timestamps[i] = _timestamps[pos];
+    }
+  }
+
+  // release the space to capture thread
+  _tail.store(tail + num, std::memory_order_release);
+  return(num);
+}
+
+size_t DirectCapture::readFrame(FrameCorrelator& correlator, uint8_t* data, size_t len, uint64_t* timestamp) {
+  while(true) {
+    // fetch next byte when the current one is used up
+    if(_bitPos >= 8) {
+      if(read(&_bitByte, 1, &_bitTimestamp) == 0) {
+        return(0);
+      }
+      _bitPos = 0;
+    }
+
+    // feed the correlator one bit at a time, so that the rest of the byte is kept for the next frame
+    uint8_t bit = (_bitByte >> (7 - _bitPos)) & 0x01;
+    _bitPos++;
+    if(correlator.processBit(bit, _bitTimestamp)) {
+      return(correlator.readFrame(data, len, timestamp));
+    }
+  }
+}
+
+uint32_t DirectCapture::getDropped() const {
+  // each dropped clock edge is one lost bit, round up to bytes
+  return(_overflows.load() + (_clockDropped.load() + 7) / 8);
+}
+
+void DirectCapture::captureLoop() {
+  GPIOEvent events[DIRECT_CAPTURE_EVENT_BATCH];
+  uint8_t dataLevel = (_gpio.getValue(1) > 0) ? 1 : 0;
+  uint8_t byte = 0;
+  uint8_t bits = 0;
+  uint64_t byteTimestamp = 0;
+  uint32_t clkSeqno = 0;
+
+  while(_running.load(std::memory_order_relaxed)) {
+    // short timeout so that end() is not blocked for long
+    int num = _gpio.read(events, DIRECT_CAPTURE_EVENT_BATCH, 100);
+    if(num <= 0) {
+      continue;
+    }
+
+    for(int i = 0; i < num; i++) {
+      // data edges just update the current level
+      if(events[i].line == 1) {
+        dataLevel = events[i].rising ? 1 : 0;
+        continue;
+      }
+
+      // clock line only reports rising edges, so each gap in its sequence is one lost bit
+      if((clkSeqno != 0) && (events[i].lineSeqno != clkSeqno + 1)) {
+        _clockDropped.fetch_add(events[i].lineSeqno - clkSeqno - 1, std::memory_order_relaxed);
+      }
+      clkSeqno = events[i].lineSeqno;
+
+      // sample data on clock rising edge
+      if(!events[i].rising) {
+        continue;
+      }
+      if(bits == 0) {
+        byteTimestamp = events[i].timestamp;
+      }
+      byte = (byte << 1) | dataLevel;
+      bits++;
+      if(bits < 8) {
+        continue;
+      }
+
+      // push complete byte into the ring buffer
+      uint32_t head = _head.load(std::memory_order_relaxed);
+      if(head - _tail.load(std::memory_order_acquire) >= DIRECT_CAPTURE_RING_SIZE) {
+        _overflows.fetch_add(1, std::memory_order_relaxed);
+      } else {
+        uint32_t pos = head & (DIRECT_CAPTURE_RING_SIZE - 1);
+        _data[pos] = byte;
+        _timestamps[pos] = byteTimestamp;
+        _head.store(head + 1, std::memory_order_release);
+      }
+      byte = 0;
+      bits = 0;
+    }
+  }
+}
+
+#endif
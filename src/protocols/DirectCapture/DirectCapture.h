@@ -0,0 +1,134 @@
+#ifndef _RADIOLIB_DIRECT_CAPTURE_H
+#define _RADIOLIB_DIRECT_CAPTURE_H
+
+#ifdef LINUX
+  #include <atomic>
+  #include <thread>
+#endif
+
+#include "../../TypeDef.h"
+#include "SyncWordCorrelator.h"
+
+#ifdef LINUX
+
+#include "../PhysicalLayer/PhysicalLayer.h"
+#include "../../linux-workarounds/GPIO/GPIOEvents.h"
+
+// size of capture ring buffer in bytes, must be a power of 2
+#ifndef DIRECT_CAPTURE_RING_SIZE
+#define DIRECT_CAPTURE_RING_SIZE                      4096
+#endif
+
+// number of GPIO events processed per read
+#define DIRECT_CAPTURE_EVENT_BATCH                    64
+
+/*!
+  \class DirectCapture
+
+  \brief Captures raw bitstream from module in direct receive mode on Linux. DIO1 (data clock) and DIO2 (data) edges
+  are read from GPIO character device in a dedicated thread, DIO2 is sampled on each rising edge of DIO1
+  and the bits are packed MSB first into a lock-free single-producer/single-consumer ring buffer.
+  Each captured byte is tagged with kernel timestamp of its first bit.
+*/
+class DirectCapture {
+  public:
+    /*!
+      \brief Default constructor.
+
+      \param phy Pointer to the wireless module providing PhysicalLayer communication.
+    */
+    DirectCapture(PhysicalLayer* phy);
+
+    /*!
+      \brief Default destructor, stops the capture.
+    */
+    ~DirectCapture();
+
+    /*!
+      \brief Switches the module to direct receive mode and starts capture thread.
+
+      \param chip Path to GPIO chip device, e.g. "/dev/gpiochip0".
+
+      \param clkLine Offset of the GPIO line connected to DIO1 (data clock).
+
+      \param dataLine Offset of the GPIO line connected to DIO2 (data).
+
+      \returns \ref status_codes
+    */
+    int16_t begin(const char* chip, uint32_t clkLine, uint32_t dataLine);
+
+    /*!
+      \brief Stops capture thread and releases GPIO lines. Module is left in direct receive mode.
+    */
+    void end();
+
+    /*!
+      \brief Gets number of captured bytes waiting in the ring buffer.
+
+      \returns Number of bytes available.
+    */
+    size_t available() const;
+
+    /*!
+      \brief Reads captured bytes from the ring buffer.
+
+      \param data Pointer to array to save the bytes to.
+
+      \param len Size of data array.
+
+      \param timestamps Pointer to array to save timestamp of the first bit of each byte to, in nanoseconds (CLOCK_MONOTONIC). Can be NULL.
+
+      \returns Number of bytes read.
+    */
+    size_t read(uint8_t* data, size_t len, uint64_t* timestamps = NULL);
+
+    /*!
+      \brief Feeds captured bits into frame correlator until a complete frame is found or the ring buffer is empty.
+
+      \param correlator Frame correlator to use, e.g. SyncWordCorrelator.
+
+      \param data Pointer to array to save the frame to.
+
+      \param len Size of data array.
+
+      \param timestamp Pointer to variable to save frame timestamp to. Can be NULL.
+
+      \returns Number of frame bytes read, or 0 when no complete frame was found yet.
+    */
+    size_t readFrame(FrameCorrelator& correlator, uint8_t* data, size_t len, uint64_t* timestamp = NULL);
+
+    /*!
+      \brief Gets number of lost bytes, either because the ring buffer was full or because kernel dropped some clock edges.
+      Dropped data line edges are not counted, as they do not shift the bitstream.
+
+      \returns Number of lost bytes.
+    */
+    uint32_t getDropped() const;
+
+#ifndef RADIOLIB_GODMODE
+  private:
+#endif
+    PhysicalLayer* _phy;
+    GPIOEvents _gpio;
+    std::thread _thread;
+    std::atomic<bool> _running;
+
+    // ring buffer, written by capture thread only
+    uint8_t _data[DIRECT_CAPTURE_RING_SIZE];
+    uint64_t _timestamps[DIRECT_CAPTURE_RING_SIZE];
+    std::atomic<uint32_t> _head;
+    std::atomic<uint32_t> _tail;
+    std::atomic<uint32_t> _overflows;
+    std::atomic<uint32_t> _clockDropped;
+
+    // partially consumed byte for readFrame
+    uint8_t _bitByte;
+    uint8_t _bitPos;
+    uint64_t _bitTimestamp;
+
+    void captureLoop();
+};
+
+#endif
+
+#endif
@@ -0,0 +1,105 @@
+#include "SyncWordCorrelator.h"
+
+SyncWordCorrelator::SyncWordCorrelator() {
+  _syncWord = 0;
+  _syncMask = 0;
+  _syncBits = 32;
+  _maxErrors = 0;
+  _frameLength = 0;
+  reset();
+}
+
+int16_t SyncWordCorrelator::begin(uint32_t syncWord, uint8_t syncBits, uint8_t maxErrors, size_t frameLength) {
+  // check parameters
+  if((syncBits == 0) || (syncBits > 32) || (maxErrors >= syncBits)) {
+    return(ERR_INVALID_SYNC_WORD);
+  }
+  if((frameLength == 0) || (frameLength > SYNC_CORRELATOR_MAX_FRAME_LENGTH)) {
+    return(ERR_PACKET_TOO_LONG);
+  }
+
+  // save configuration
+  _syncMask = (syncBits == 32) ? 0xFFFFFFFF : (((uint32_t)1 << syncBits) - 1);
+  _syncWord = syncWord & _syncMask;
+  _syncBits = syncBits;
+  _maxErrors = maxErrors;
+  _frameLength = frameLength;
+  reset();
+  return(ERR_NONE);
+}
+
+void SyncWordCorrelator::reset() {
+  _shiftReg = 0;
+  _shiftCount = 0;
+  _collecting = false;
+  _ready = false;
+  _bitPos = 0;
+  _syncTimestamp = 0;
+}
+
+bool SyncWordCorrelator::processBit(uint8_t bit, uint64_t timestamp) {
+  // hold the frame until it is read
+  if(_ready) {
+    return(true);
+  }
+
+  if(_collecting) {
+    // pack frame bits MSB first
+    uint8_t mask = 0x80 >> (_bitPos % 8);
+    if(bit) {
+      _frame[_bitPos / 8] |= mask;
+    } else {
+      _frame[_bitPos / 8] &= ~mask;
+    }
+    _bitPos++;
+
+    if(_bitPos == _frameLength * 8) {
+      _collecting = false;
+      _ready = true;
+    }
+    return(_ready);
+  }
+
+  // shift in new bit and compare with sync word
+  _shiftReg = (_shiftReg << 1) | (bit & 0x01);
+  if(_shiftCount < _syncBits) {
+    // wait until the register holds one full sync word
+    _shiftCount++;
+    if(_shiftCount < _syncBits) {
+      return(false);
+    }
+  }
+
+  if(countBits((_shiftReg & _syncMask) ^ _syncWord) <= _maxErrors) {
+    _collecting = true;
+    _bitPos = 0;
+    _syncTimestamp = timestamp;
+  }
+  return(false);
+}
+
+size_t SyncWordCorrelator::readFrame(uint8_t* data, size_t len, uint64_t* timestamp) {
+  if(!_ready) {
+    return(0);
+  }
+
+  // copy the frame
+  if(len > _frameLength) {
+    len = _frameLength;
+  }
+  memcpy(data, _frame, len);
+  if(timestamp != NULL) {
+    *timestamp = _syncTimestamp;
+  }
+
+  // restart sync word search with empty shift register
+  reset();
+  return(len);
+}
+
+uint8_t SyncWordCorrelator::countBits(uint32_t value) {
+  // parallel bit count
+  value = value - ((value >> 1) & 0x55555555);
+  value = (value & 0x33333333) + ((value >> 2) & 0x33333333);
+  return((((value + (value >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24);
+}
@@ -0,0 +1,100 @@
+#ifndef _RADIOLIB_SYNC_WORD_CORRELATOR_H
+#define _RADIOLIB_SYNC_WORD_CORRELATOR_H
+
+#include "../../TypeDef.h"
+
+// maximum frame length that can be collected after sync word
+#define SYNC_CORRELATOR_MAX_FRAME_LENGTH              255
+
+/*!
+  \class FrameCorrelator
+
+  \brief Interface for frame detectors that run on raw bitstream, e.g. one captured in direct mode.
+  Implement this to plug a custom frame detector into DirectCapture.
+*/
+class FrameCorrelator {
+  public:
+    virtual ~FrameCorrelator() {}
+
+    /*!
+      \brief Processes one received bit.
+
+      \param bit Bit value, 0 or 1.
+
+      \param timestamp Timestamp of the bit, units are defined by the bit source.
+
+      \returns Whether a complete frame is ready to be read.
+    */
+    virtual bool processBit(uint8_t bit, uint64_t timestamp) = 0;
+
+    /*!
+      \brief Reads the complete frame and restarts sync word search.
+
+      \param data Pointer to array to save the frame to.
+
+      \param len Size of data array.
+
+      \param timestamp Pointer to variable to save timestamp of the end of sync word to. Can be NULL.
+
+      \returns Number of bytes read, or 0 when no frame is ready.
+    */
+    virtual size_t readFrame(uint8_t* data, size_t len, uint64_t* timestamp = NULL) = 0;
+};
+
+/*!
+  \class SyncWordCorrelator
+
+  \brief Detects sync word in bitstream with configurable number of bit errors, and then collects fixed-length frame following it.
+*/
+class SyncWordCorrelator: public FrameCorrelator {
+  public:
+    /*!
+      \brief Default constructor.
+    */
+    SyncWordCorrelator();
+
+    /*!
+      \brief Configures the correlator.
+
+      \param syncWord Sync word, transmitted MSB first and right-aligned.
+
+      \param syncBits Length of sync word in bits. Allowed values are 1 to 32.
+
+      \param maxErrors Maximum number of bit errors in sync word that still result in detection.
+
+      \param frameLength Length of frame following the sync word in bytes. Maximum is SYNC_CORRELATOR_MAX_FRAME_LENGTH.
+
+      \returns \ref status_codes
+    */
+    int16_t begin(uint32_t syncWord, uint8_t syncBits, uint8_t maxErrors, size_t frameLength);
+
+    /*!
+      \brief Restarts sync word search, discarding any partially collected frame.
+    */
+    void reset();
+
+    bool processBit(uint8_t bit, uint64_t timestamp);
+
+    size_t readFrame(uint8_t* data, size_t len, uint64_t* timestamp = NULL);
+
+#ifndef RADIOLIB_GODMODE
+  private:
+#endif
+    uint32_t _syncWord;
+    uint32_t _syncMask;
+    uint8_t _syncBits;
+    uint8_t _maxErrors;
+    size_t _frameLength;
+
+    uint32_t _shiftReg;
+    uint8_t _shiftCount;
+    bool _collecting;
+    bool _ready;
+    size_t _bitPos;
+    uint64_t _syncTimestamp;
+    uint8_t _frame[SYNC_CORRELATOR_MAX_FRAME_LENGTH];
+
+    static uint8_t countBits(uint32_t value);
+};
+
+#endif
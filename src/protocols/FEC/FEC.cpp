@@ -0,0 +1,344 @@
+#include "FEC.h"
+
+FECEncoder::FECEncoder(PhysicalLayer* phy, uint8_t maxFrameLength) {
+  _phy = phy;
+
+  // frame buffers are sized for FEC_MAX_FRAME_LENGTH, clamping is only needed when it is below the 8-bit limit
+  _maxFrameLength = maxFrameLength;
+  #if FEC_MAX_FRAME_LENGTH < 255
+    if(_maxFrameLength > FEC_MAX_FRAME_LENGTH) {
+      _maxFrameLength = FEC_MAX_FRAME_LENGTH;
+    }
+  #endif
+  _sourceFrames = FEC_DEFAULT_SOURCE_FRAMES;
+  _repairFrames = FEC_DEFAULT_REPAIR_FRAMES;
+  _block = 0;
+  _count = 0;
+  _symbolLength = 0;
+}
+
+int16_t FECEncoder::setBlockSize(uint8_t sourceFrames, uint8_t repairFrames) {
+  if((sourceFrames == 0) || (sourceFrames > FEC_MAX_SOURCE_FRAMES) || (repairFrames > FEC_MAX_REPAIR_FRAMES)) {
+    return(ERR_INVALID_BLOCK_SIZE);
+  }
+
+  // finish the current block with the old size
+  int16_t state = flush();
+  RADIOLIB_ASSERT(state);
+
+  _sourceFrames = sourceFrames;
+  _repairFrames = repairFrames;
+  return(state);
+}
+
+int16_t FECEncoder::transmit(uint8_t* data, size_t len) {
+  if(len + FEC_HEADER_LENGTH + 1 > _maxFrameLength) {
+    return(ERR_PACKET_TOO_LONG);
+  }
+
+  // source frame is sent without padding
+  _frame[0] = _block;
+  _frame[1] = _count;
+  _frame[2] = _sourceFrames;
+  _frame[3] = len;
+  memcpy(_frame + FEC_HEADER_LENGTH + 1, data, len);
+  int16_t state = _phy->transmit(_frame, FEC_HEADER_LENGTH + 1 + len);
+  RADIOLIB_ASSERT(state);
+
+  // clear repair symbols at the start of block
+  if(_count == 0) {
+    memset(_repair, 0x00, sizeof(_repair));
+    _symbolLength = 0;
+  }
+
+  // add the new symbol to all repair symbols, padding is zero so it does not contribute
+  uint8_t symbolLength = len + 1;
+  for(uint8_t i = 0; i < _repairFrames; i++) {
+    GF256::mulAddRegion(_repair[i], _frame + FEC_HEADER_LENGTH, coefficient(i, _count), symbolLength);
+  }
+  if(symbolLength > _symbolLength) {
+    _symbolLength = symbolLength;
+  }
+  _count++;
+
+  if(_count >= _sourceFrames) {
+    return(flush());
+  }
+  return(ERR_NONE);
+}
+
+int16_t FECEncoder::flush() {
+  if(_count == 0) {
+    return(ERR_NONE);
+  }
+
+  // next block starts even if some repair frame fails
+  uint8_t block = _block;
+  uint8_t count = _count;
+  _block++;
+  _count = 0;
+
+  // repair frames carry the actual number of source frames, so that block may end early
+  for(uint8_t i = 0; i < _repairFrames; i++) {
+    _frame[0] = block;
+    _frame[1] = count + i;
+    _frame[2] = count;
+    memcpy(_frame + FEC_HEADER_LENGTH, _repair[i], _symbolLength);
+    int16_t state = _phy->transmit(_frame, FEC_HEADER_LENGTH + _symbolLength);
+    RADIOLIB_ASSERT(state);
+  }
+
+  return(ERR_NONE);
+}
+
+uint8_t FECEncoder::coefficient(uint8_t repair, uint8_t source) {
+  // Cauchy matrix 1/(x + y) with x = 255 - repair and y = source, every square submatrix is invertible
+  return(GF256::inv((255 - repair) ^ source));
+}
+
+FECDecoder::FECDecoder(PhysicalLayer* phy, uint8_t maxFrameLength) {
+  _phy = phy;
+
+  // frame buffers are sized for FEC_MAX_FRAME_LENGTH, clamping is only needed when it is below the 8-bit limit
+  _maxFrameLength = maxFrameLength;
+  #if FEC_MAX_FRAME_LENGTH < 255
+    if(_maxFrameLength > FEC_MAX_FRAME_LENGTH) {
+      _maxFrameLength = FEC_MAX_FRAME_LENGTH;
+    }
+  #endif
+  _active = false;
+  _done = false;
+  _block = 0;
+  _sourceFrames = FEC_MAX_SOURCE_FRAMES;
+  _symbolLength = 0;
+  _received = 0;
+  memset(_slotIndex, FEC_SLOT_EMPTY, sizeof(_slotIndex));
+  _recovered = 0;
+  _lost = 0;
+}
+
+int16_t FECDecoder::receive(void (*func)(uint8_t* data, size_t len)) {
+  int16_t state = _phy->receive(_frame, _maxFrameLength);
+  RADIOLIB_ASSERT(state);
+  return(process(_phy->getPacketLength(false), func));
+}
+
+int16_t FECDecoder::readData(void (*func)(uint8_t* data, size_t len)) {
+  int16_t state = _phy->readData(_frame, _maxFrameLength);
+  RADIOLIB_ASSERT(state);
+  return(process(_phy->getPacketLength(false), func));
+}
+
+uint32_t FECDecoder::getRecovered() {
+  return(_recovered);
+}
+
+uint32_t FECDecoder::getLost() {
+  return(_lost);
+}
+
+int16_t FECDecoder::process(size_t frameLen, void (*func)(uint8_t* data, size_t len)) {
+  // check header
+  if((frameLen <= FEC_HEADER_LENGTH) || (frameLen > _maxFrameLength)) {
+    return(ERR_INVALID_FRAME);
+  }
+  uint8_t block = _frame[0];
+  uint8_t index = _frame[1];
+  uint8_t sourceFrames = _frame[2];
+  if((sourceFrames == 0) || (sourceFrames > FEC_MAX_SOURCE_FRAMES) || (index >= sourceFrames + FEC_MAX_REPAIR_FRAMES)) {
+    return(ERR_INVALID_FRAME);
+  }
+  uint8_t* symbol = _frame + FEC_HEADER_LENGTH;
+  uint8_t symbolLength = frameLen - FEC_HEADER_LENGTH;
+
+  if(!_active || (block != _block)) {
+    startBlock(block);
+  }
+
+  // all source frames of this block were already passed to the user
+  if(_done) {
+    return(ERR_NONE);
+  }
+
+  // block ended early if repair frame has lower number of source frames
+  if(sourceFrames < _sourceFrames) {
+    _sourceFrames = sourceFrames;
+  }
+
+  if(index < sourceFrames) {
+    // source frame
+    if(symbol[0] != symbolLength - 1) {
+      return(ERR_INVALID_FRAME);
+    }
+    if(_received & ((uint32_t)1 << index)) {
+      return(ERR_NONE);
+    }
+
+    // the slot may hold repair frame received out of order, move it away or drop it
+    if(_slotIndex[index] != FEC_SLOT_EMPTY) {
+      uint8_t slot = findSlot(FEC_SLOT_EMPTY);
+      if(slot != FEC_SLOT_EMPTY) {
+        memcpy(_slots[slot], _slots[index], _symbolLength);
+        _slotIndex[slot] = _slotIndex[index];
+      }
+    }
+
+    // padding must be zero for rebuild
+    memcpy(_slots[index], symbol, symbolLength);
+    memset(_slots[index] + symbolLength, 0x00, FEC_MAX_SYMBOL_LENGTH - symbolLength);
+    _slotIndex[index] = index;
+    _received |= (uint32_t)1 << index;
+    func(_slots[index] + 1, symbol[0]);
+
+  } else {
+    // repair frame, all of them have the length of the longest source symbol
+    uint8_t repair = FEC_SLOT_REPAIR | (index - sourceFrames);
+    if(_symbolLength == 0) {
+      _symbolLength = symbolLength;
+    } else if(symbolLength != _symbolLength) {
+      return(ERR_INVALID_FRAME);
+    }
+    if(findSlot(repair) != FEC_SLOT_EMPTY) {
+      return(ERR_NONE);
+    }
+
+    // no free slot means enough frames were already received
+    uint8_t slot = findSlot(FEC_SLOT_EMPTY);
+    if(slot != FEC_SLOT_EMPTY) {
+      memcpy(_slots[slot], symbol, symbolLength);
+      _slotIndex[slot] = repair;
+    }
+  }
+
+  return(rebuild(func));
+}
+
+void FECDecoder::startBlock(uint8_t block) {
+  // source frames of the previous block that were neither received nor rebuilt
+  if(_active && !_done) {
+    for(uint8_t i = 0; i < _sourceFrames; i++) {
+      if(!(_received & ((uint32_t)1 << i))) {
+        _lost++;
+      }
+    }
+  }
+
+  _active = true;
+  _done = false;
+  _block = block;
+  _sourceFrames = FEC_MAX_SOURCE_FRAMES;
+  _symbolLength = 0;
+  _received = 0;
+  memset(_slotIndex, FEC_SLOT_EMPTY, sizeof(_slotIndex));
+}
+
+int16_t FECDecoder::rebuild(void (*func)(uint8_t* data, size_t len)) {
+  // find missing source frames
+  uint8_t missing[FEC_MAX_REPAIR_FRAMES];
+  uint8_t numMissing = 0;
+  for(uint8_t i = 0; i < _sourceFrames; i++) {
+    if(!(_received & ((uint32_t)1 << i))) {
+      if(numMissing == FEC_MAX_REPAIR_FRAMES) {
+        return(ERR_NONE);
+      }
+      missing[numMissing++] = i;
+    }
+  }
+  if(numMissing == 0) {
+    _done = true;
+    return(ERR_NONE);
+  }
+
+  // one repair frame is needed for each missing source frame
+  uint8_t rows[FEC_MAX_REPAIR_FRAMES];
+  uint8_t numRows = 0;
+  for(uint8_t i = 0; (i < FEC_MAX_SOURCE_FRAMES) && (numRows < numMissing); i++) {
+    if((_slotIndex[i] != FEC_SLOT_EMPTY) && (_slotIndex[i] & FEC_SLOT_REPAIR)) {
+      rows[numRows++] = i;
+    }
+  }
+  if(numRows < numMissing) {
+    return(ERR_NONE);
+  }
+
+  // subtract received source frames from repair symbols, what remains depends only on missing frames
+  uint8_t matrix[FEC_MAX_REPAIR_FRAMES][FEC_MAX_REPAIR_FRAMES];
+  for(uint8_t r = 0; r < numRows; r++) {
+    uint8_t repair = _slotIndex[rows[r]] & ~FEC_SLOT_REPAIR;
+    for(uint8_t i = 0; i < _sourceFrames; i++) {
+      if(_received & ((uint32_t)1 << i)) {
+        GF256::mulAddRegion(_slots[rows[r]], _slots[i], FECEncoder::coefficient(repair, i), _symbolLength);
+      }
+    }
+    for(uint8_t c = 0; c < numMissing; c++) {
+      matrix[r][c] = FECEncoder::coefficient(repair, missing[c]);
+    }
+  }
+
+  // Gauss-Jordan elimination, row operations are applied to repair symbols as well
+  for(uint8_t c = 0; c < numMissing; c++) {
+    uint8_t pivot = c;
+    while((pivot < numRows) && (matrix[pivot][c] == 0)) {
+      pivot++;
+    }
+    if(pivot == numRows) {
+      return(ERR_INVALID_FRAME);
+    }
+
+    // swap rows
+    if(pivot != c) {
+      for(uint8_t k = 0; k < numMissing; k++) {
+        uint8_t tmp = matrix[c][k];
+        matrix[c][k] = matrix[pivot][k];
+        matrix[pivot][k] = tmp;
+      }
+      uint8_t tmp = rows[c];
+      rows[c] = rows[pivot];
+      rows[pivot] = tmp;
+    }
+
+    // normalize pivot to 1
+    uint8_t scale = GF256::inv(matrix[c][c]);
+    for(uint8_t k = 0; k < numMissing; k++) {
+      matrix[c][k] = GF256::mul(matrix[c][k], scale);
+    }
+    GF256::mulRegion(_slots[rows[c]], scale, _symbolLength);
+
+    // eliminate column from all other rows
+    for(uint8_t r = 0; r < numRows; r++) {
+      uint8_t factor = matrix[r][c];
+      if((r == c) || (factor == 0)) {
+        continue;
+      }
+      for(uint8_t k = 0; k < numMissing; k++) {
+        matrix[r][k] ^= GF256::mul(factor, matrix[c][k]);
+      }
+      GF256::mulAddRegion(_slots[rows[r]], _slots[rows[c]], factor, _symbolLength);
+    }
+  }
+
+  // each row now holds one rebuilt source symbol
+  _done = true;
+  for(uint8_t c = 0; c < numMissing; c++) {
+    uint8_t* symbol = _slots[rows[c]];
+    _received |= (uint32_t)1 << missing[c];
+    if(symbol[0] >= _symbolLength) {
+      _lost++;
+      continue;
+    }
+    _recovered++;
+    func(symbol + 1, symbol[0]);
+  }
+
+  return(ERR_NONE);
+}
+
+uint8_t FECDecoder::findSlot(uint8_t index) {
+  // search from the end, so that repair frames are stored away from the source frames
+  for(int16_t i = FEC_MAX_SOURCE_FRAMES - 1; i >= 0; i--) {
+    if(_slotIndex[i] == index) {
+      return(i);
+    }
+  }
+  return(FEC_SLOT_EMPTY);
+}
@@ -0,0 +1,200 @@
+#ifndef _RADIOLIB_FEC_H
+#define _RADIOLIB_FEC_H
+
+#include "../../TypeDef.h"
+#include "../PhysicalLayer/PhysicalLayer.h"
+#include "GF256.h"
+
+// frame header: block ID, frame index, number of source frames in block
+#define FEC_HEADER_LENGTH                             3
+
+// each symbol starts with payload length, so that zero padding can be removed
+#ifndef FEC_MAX_FRAME_LENGTH
+  #if defined(__AVR__)
+    #define FEC_MAX_FRAME_LENGTH                      64
+  #else
+    #define FEC_MAX_FRAME_LENGTH                      255
+  #endif
+#endif
+#define FEC_MAX_SYMBOL_LENGTH                         (FEC_MAX_FRAME_LENGTH - FEC_HEADER_LENGTH)
+
+// block size limits, source frames are tracked in 32-bit mask
+// each frame is buffered, so large blocks are only allowed on Linux
+#ifndef FEC_MAX_SOURCE_FRAMES
+  #if defined(LINUX)
+    #define FEC_MAX_SOURCE_FRAMES                     32
+  #elif defined(__AVR__)
+    #define FEC_MAX_SOURCE_FRAMES                     4
+  #else
+    #define FEC_MAX_SOURCE_FRAMES                     8
+  #endif
+#endif
+
+#ifndef FEC_MAX_REPAIR_FRAMES
+  #if defined(LINUX)
+    #define FEC_MAX_REPAIR_FRAMES                     16
+  #elif defined(__AVR__)
+    #define FEC_MAX_REPAIR_FRAMES                     2
+  #else
+    #define FEC_MAX_REPAIR_FRAMES                     4
+  #endif
+#endif
+
+// default block size
+#define FEC_DEFAULT_SOURCE_FRAMES                     4
+#define FEC_DEFAULT_REPAIR_FRAMES                     2
+
+// decoder slot states
+#define FEC_SLOT_EMPTY                                0xFF
+#define FEC_SLOT_REPAIR                               0x80
+
+/*!
+  \class FECEncoder
+
+  \brief Erasure coding transmitter. Payloads are sent immediately as systematic source frames, and after every block of source frames,
+  repair frames are sent. Repair frames are computed with Cauchy Reed-Solomon code over GF(256), so the receiver can rebuild
+  any lost source frames as long as the total number of lost frames in block does not exceed the number of repair frames.
+  No reverse channel is needed, so this suits one-way broadcast.
+*/
+class FECEncoder {
+  public:
+    /*!
+      \brief Default constructor.
+
+      \param phy Pointer to the wireless module providing PhysicalLayer communication.
+
+      \param maxFrameLength Maximum length of transmitted frame in bytes, e.g. 63 for FSK without streaming. Defaults to FEC_MAX_FRAME_LENGTH, larger values are clamped to it.
+    */
+    FECEncoder(PhysicalLayer* phy, uint8_t maxFrameLength = FEC_MAX_FRAME_LENGTH);
+
+    /*!
+      \brief Sets block size. Block currently in progress is flushed first.
+
+      \param sourceFrames Number of source frames in block. Allowed values range from 1 to FEC_MAX_SOURCE_FRAMES.
+
+      \param repairFrames Number of repair frames sent after block. Allowed values range from 0 to FEC_MAX_REPAIR_FRAMES.
+
+      \returns \ref status_codes
+    */
+    int16_t setBlockSize(uint8_t sourceFrames, uint8_t repairFrames);
+
+    /*!
+      \brief Transmits payload as source frame. Repair frames are transmitted once the block is complete.
+
+      \param data Payload to transmit.
+
+      \param len Length of payload in bytes. Maximum is 4 bytes less than maximum frame length.
+
+      \returns \ref status_codes
+    */
+    int16_t transmit(uint8_t* data, size_t len);
+
+    /*!
+      \brief Ends current block early and transmits its repair frames.
+
+      \returns \ref status_codes
+    */
+    int16_t flush();
+
+    /*!
+      \brief Gets coefficient of the Cauchy matrix used to compute repair frames.
+
+      \param repair Index of repair frame within block.
+
+      \param source Index of source frame within block.
+
+      \returns Coefficient the source frame is multiplied by when added to repair frame.
+    */
+    static uint8_t coefficient(uint8_t repair, uint8_t source);
+
+#ifndef RADIOLIB_GODMODE
+  private:
+#endif
+    PhysicalLayer* _phy;
+    uint8_t _maxFrameLength;
+    uint8_t _sourceFrames;
+    uint8_t _repairFrames;
+    uint8_t _block;
+    uint8_t _count;
+    uint8_t _symbolLength;
+    uint8_t _frame[FEC_MAX_FRAME_LENGTH];
+    uint8_t _repair[FEC_MAX_REPAIR_FRAMES][FEC_MAX_SYMBOL_LENGTH];
+};
+
+/*!
+  \class FECDecoder
+
+  \brief Erasure coding receiver. Source frames are passed to the user as soon as they arrive, lost source frames are rebuilt
+  from repair frames and passed to the user once enough frames of the block were received, i.e. possibly out of order.
+  Frames with CRC error are simply treated as lost.
+*/
+class FECDecoder {
+  public:
+    /*!
+      \brief Default constructor.
+
+      \param phy Pointer to the wireless module providing PhysicalLayer communication.
+
+      \param maxFrameLength Maximum length of received frame in bytes, must be the same as on transmitter side. Defaults to FEC_MAX_FRAME_LENGTH, larger values are clamped to it.
+    */
+    FECDecoder(PhysicalLayer* phy, uint8_t maxFrameLength = FEC_MAX_FRAME_LENGTH);
+
+    /*!
+      \brief Receives a single frame and passes all payloads that became available to the user.
+
+      \param func Function called for each received or rebuilt payload.
+
+      \returns \ref status_codes
+    */
+    int16_t receive(void (*func)(uint8_t* data, size_t len));
+
+    /*!
+      \brief Reads a single frame after interrupt-driven reception and passes all payloads that became available to the user.
+
+      \param func Function called for each received or rebuilt payload.
+
+      \returns \ref status_codes
+    */
+    int16_t readData(void (*func)(uint8_t* data, size_t len));
+
+    /*!
+      \brief Gets number of source frames rebuilt from repair frames.
+
+      \returns Number of rebuilt source frames.
+    */
+    uint32_t getRecovered();
+
+    /*!
+      \brief Gets number of source frames that could not be rebuilt, counted when the next block starts.
+
+      \returns Number of lost source frames.
+    */
+    uint32_t getLost();
+
+#ifndef RADIOLIB_GODMODE
+  private:
+#endif
+    PhysicalLayer* _phy;
+    uint8_t _maxFrameLength;
+    uint8_t _frame[FEC_MAX_FRAME_LENGTH];
+
+    // current block
+    bool _active;
+    bool _done;
+    uint8_t _block;
+    uint8_t _sourceFrames;
+    uint8_t _symbolLength;
+    uint32_t _received;
+    uint8_t _slotIndex[FEC_MAX_SOURCE_FRAMES];
+    uint8_t _slots[FEC_MAX_SOURCE_FRAMES][FEC_MAX_SYMBOL_LENGTH];
+
+    uint32_t _recovered;
+    uint32_t _lost;
+
+    int16_t process(size_t frameLen, void (*func)(uint8_t* data, size_t len));
+    void startBlock(uint8_t block);
+    int16_t rebuild(void (*func)(uint8_t* data, size_t len));
+    uint8_t findSlot(uint8_t index);
+};
+
+#endif
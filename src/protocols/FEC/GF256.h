@@ -0,0 +1,68 @@
+#ifndef _RADIOLIB_GF256_H
+#define _RADIOLIB_GF256_H
+
+#include "../../TypeDef.h"
+
+// field generator polynomial x^8 + x^4 + x^3 + x^2 + 1
+#define GF256_POLYNOMIAL                              0x11D
+
+/*!
+  \class GF256
+
+  \brief Arithmetic in Galois field GF(2^8), used by erasure coding. Single elements are multiplied using exp/log tables stored in program memory.
+  Region kernels split the multiplier into two 16-entry tables indexed by low and high nibble, which maps directly onto byte shuffle instructions.
+  SSSE3 (x86) and NEON (AArch64) paths are used on Linux when enabled by compiler flags, otherwise a portable table lookup is used.
+*/
+class GF256 {
+  public:
+    /*!
+      \brief Multiplies two field elements.
+
+      \param a First element.
+
+      \param b Second element.
+
+      \returns Product of a and b.
+    */
+    static uint8_t mul(uint8_t a, uint8_t b);
+
+    /*!
+      \brief Multiplicative inverse of a field element.
+
+      \param a Element to invert, must not be 0.
+
+      \returns Inverse of a.
+    */
+    static uint8_t inv(uint8_t a);
+
+    /*!
+      \brief Multiplies every byte in region by constant, in place.
+
+      \param dst Region to multiply.
+
+      \param c Constant multiplier.
+
+      \param len Length of region in bytes.
+    */
+    static void mulRegion(uint8_t* dst, uint8_t c, size_t len);
+
+    /*!
+      \brief Multiplies source region by constant and adds (XORs) it to destination region.
+
+      \param dst Destination region.
+
+      \param src Source region, must not partially overlap destination.
+
+      \param c Constant multiplier.
+
+      \param len Length of both regions in bytes.
+    */
+    static void mulAddRegion(uint8_t* dst, const uint8_t* src, uint8_t c, size_t len);
+
+#ifndef RADIOLIB_GODMODE
+  private:
+#endif
+    static void region(uint8_t* dst, const uint8_t* src, uint8_t c, size_t len, bool add);
+};
+
+#endif
@@ -0,0 +1,267 @@
+#include "Gateway.h"
+
+Gateway::Gateway() {
+  _numRadios = 0;
+  _head = 0;
+  _count = 0;
+  _dropped = 0;
+  _errors = 0;
+#ifdef LINUX
+  _eventsDropped = 0;
+  _running.store(false);
+#endif
+}
+
+#ifdef LINUX
+Gateway::~Gateway() {
+  stop();
+  _events.end();
+}
+#endif
+
+int16_t Gateway::addRadio(SX127x* radio, float freq, const SX127xProfile& profile) {
+  if(_numRadios >= GATEWAY_MAX_RADIOS) {
+    return(ERR_TOO_MANY_RADIOS);
+  }
+
+  GatewayRadio* r = &_radios[_numRadios];
+  r->radio = radio;
+  r->freq = freq;
+  r->profile = profile;
+  r->transmitting = false;
+  _numRadios++;
+  return(ERR_NONE);
+}
+
+int16_t Gateway::begin() {
+  return(configure());
+}
+
+#ifdef LINUX
+int16_t Gateway::begin(const char* chip, const uint32_t* dio0Lines) {
+  int16_t state = configure();
+  RADIOLIB_ASSERT(state);
+
+  // all lines in one request, so that events from different radios share a single sequence
+  uint8_t edges[GATEWAY_MAX_RADIOS];
+  for(uint8_t i = 0; i < _numRadios; i++) {
+    edges[i] = RISING;
+  }
+  _events.end();
+  state = _events.begin(chip, dio0Lines, edges, _numRadios);
+  _eventsDropped = 0;
+  return(state);
+}
+
+int16_t Gateway::start() {
+  if(_events.getFd() < 0) {
+    return(ERR_GPIO_UNAVAILABLE);
+  }
+
+  stop();
+  _running.store(true);
+  _thread = std::thread(&Gateway::run, this);
+  return(ERR_NONE);
+}
+
+void Gateway::stop() {
+  _running.store(false);
+  if(_thread.joinable()) {
+    _thread.join();
+  }
+}
+
+void Gateway::run() {
+  while(_running.load()) {
+    service(GATEWAY_SERVICE_TIMEOUT);
+  }
+}
+#endif
+
+int16_t Gateway::service(int timeout) {
+#ifdef LINUX
+  if(_events.getFd() >= 0) {
+    // wait for interrupts without holding the lock, so that transmit requests are not blocked
+    GPIOEvent events[GATEWAY_EVENT_BATCH];
+    int num = _events.read(events, GATEWAY_EVENT_BATCH, timeout);
+    if(num < 0) {
+      return(ERR_GPIO_UNAVAILABLE);
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    for(int i = 0; i < num; i++) {
+      if(events[i].rising) {
+        handle(events[i].line, events[i].timestamp / 1000);
+      }
+    }
+
+    // DIO0 stays high until interrupt flags are cleared, so edges lost on timeout or kernel buffer overflow can be recovered from line levels
+    if((num == 0) || (_events.getDropped() != _eventsDropped)) {
+      _eventsDropped = _events.getDropped();
+      for(uint8_t i = 0; i < _numRadios; i++) {
+        if(_events.getValue(i) == 1) {
+          handle(i, Module::getMicros());
+        }
+      }
+    }
+    return(ERR_NONE);
+  }
+
+  std::lock_guard<std::mutex> lock(_mutex);
+#else
+  (void)timeout;
+#endif
+
+  // poll DIO0 pins
+  for(uint8_t i = 0; i < _numRadios; i++) {
+    if(Module::digitalRead(_radios[i].radio->getMod()->getIrq())) {
+      handle(i, Module::getMicros());
+    }
+  }
+  return(ERR_NONE);
+}
+
+size_t Gateway::available() {
+#ifdef LINUX
+  std::lock_guard<std::mutex> lock(_mutex);
+#endif
+  return(_count);
+}
+
+bool Gateway::read(GatewayPacket* packet) {
+#ifdef LINUX
+  std::lock_guard<std::mutex> lock(_mutex);
+#endif
+  if(_count == 0) {
+    return(false);
+  }
+
+  memcpy(packet, &_queue[_head], sizeof(GatewayPacket));
+  _head = (_head + 1) % GATEWAY_QUEUE_SIZE;
+  _count--;
+  return(true);
+}
+
+int16_t Gateway::transmit(uint8_t* data, size_t len, float freq) {
+#ifdef LINUX
+  std::lock_guard<std::mutex> lock(_mutex);
+#endif
+
+  // find radio on the requested channel that is neither transmitting nor receiving
+  for(uint8_t i = 0; i < _numRadios; i++) {
+    GatewayRadio* r = &_radios[i];
+    if(r->transmitting || (fabs(r->freq - freq) > GATEWAY_FREQ_TOLERANCE)) {
+      continue;
+    }
+
+    // packet that was received but not serviced yet would be lost, so it is read first
+    uint8_t flags = r->radio->getMod()->SPIreadRegister(SX127X_REG_IRQ_FLAGS);
+    if(flags & SX127X_CLEAR_IRQ_FLAG_RX_DONE) {
+      handle(i, Module::getMicros());
+      flags = r->radio->getMod()->SPIreadRegister(SX127X_REG_IRQ_FLAGS);
+    }
+
+    // valid header means packet is being received
+    if(flags & SX127X_CLEAR_IRQ_FLAG_VALID_HEADER) {
+      continue;
+    }
+
+    // DIO0 switches to TX done, reception is restarted when it activates
+    int16_t state = r->radio->startTransmit(data, len);
+    if(state != ERR_NONE) {
+      r->radio->startReceive();
+      return(state);
+    }
+    r->transmitting = true;
+    return(ERR_NONE);
+  }
+
+  return(ERR_NO_IDLE_RADIO);
+}
+
+uint32_t Gateway::getDropped() {
+  return(_dropped);
+}
+
+uint32_t Gateway::getErrors() {
+  return(_errors);
+}
+
+int16_t Gateway::configure() {
+  for(uint8_t i = 0; i < _numRadios; i++) {
+    GatewayRadio* r = &_radios[i];
+    r->transmitting = false;
+
+    int16_t state = r->radio->setFrequency(r->freq);
+    RADIOLIB_ASSERT(state);
+
+    state = r->radio->applyProfile(r->profile);
+    RADIOLIB_ASSERT(state);
+
+    state = r->radio->startReceive();
+    RADIOLIB_ASSERT(state);
+  }
+  return(ERR_NONE);
+}
+
+void Gateway::handle(uint8_t index, uint32_t timestamp) {
+  if(index >= _numRadios) {
+    return;
+  }
+  GatewayRadio* r = &_radios[index];
+
+  // edges may be serviced late, so the event is determined from interrupt flags
+  uint8_t flags = r->radio->getMod()->SPIreadRegister(SX127X_REG_IRQ_FLAGS);
+
+  // transmission finished
+  if(flags & SX127X_CLEAR_IRQ_FLAG_TX_DONE) {
+    r->transmitting = false;
+    r->radio->startReceive();
+    return;
+  }
+
+  // stale edge, e.g. reception that was already serviced before transmission started
+  if(!(flags & SX127X_CLEAR_IRQ_FLAG_RX_DONE)) {
+    return;
+  }
+
+  // packet received, reception is restarted in any case
+  size_t len = r->radio->getPacketLength();
+  if(len > GATEWAY_MAX_PACKET_LENGTH) {
+    _dropped++;
+  } else {
+    int16_t state = r->radio->readData(_packet.data, len);
+    if(state == ERR_NONE) {
+      _packet.len = len;
+      _packet.radio = index;
+      _packet.freq = r->freq;
+      _packet.rssi = r->radio->getRSSI();
+      _packet.snr = r->radio->getSNR();
+      _packet.timestamp = timestamp;
+      insert(_packet);
+    } else {
+      _errors++;
+    }
+  }
+  r->radio->startReceive();
+}
+
+void Gateway::insert(const GatewayPacket& packet) {
+  if(_count == GATEWAY_QUEUE_SIZE) {
+    _dropped++;
+    return;
+  }
+
+  // radios may be serviced out of order, move the new packet before all later ones
+  size_t pos = (_head + _count) % GATEWAY_QUEUE_SIZE;
+  _count++;
+  while(pos != _head) {
+    size_t prev = (pos + GATEWAY_QUEUE_SIZE - 1) % GATEWAY_QUEUE_SIZE;
+    if((int32_t)(_queue[prev].timestamp - packet.timestamp) <= 0) {
+      break;
+    }
+    memcpy(&_queue[pos], &_queue[prev], sizeof(GatewayPacket));
+    pos = prev;
+  }
+  memcpy(&_queue[pos], &packet, sizeof(GatewayPacket));
+}
@@ -0,0 +1,252 @@
+#ifndef _RADIOLIB_GATEWAY_H
+#define _RADIOLIB_GATEWAY_H
+
+#ifdef LINUX
+  #include <atomic>
+  #include <thread>
+  #include <mutex>
+#endif
+
+#include "../../TypeDef.h"
+#include "../../Module.h"
+#include "../../modules/SX127x/SX127x.h"
+
+#ifdef LINUX
+  #include "../../linux-workarounds/GPIO/GPIOEvents.h"
+#endif
+
+// number of radios, on Linux all DIO0 lines are requested together
+#ifndef GATEWAY_MAX_RADIOS
+  #if defined(__AVR__)
+    #define GATEWAY_MAX_RADIOS                        2
+  #else
+    #define GATEWAY_MAX_RADIOS                        8
+  #endif
+#endif
+
+// number of received packets waiting to be read, each one holds a full packet buffer
+#ifndef GATEWAY_QUEUE_SIZE
+  #if defined(LINUX)
+    #define GATEWAY_QUEUE_SIZE                        64
+  #elif defined(__AVR__)
+    #define GATEWAY_QUEUE_SIZE                        4
+  #else
+    #define GATEWAY_QUEUE_SIZE                        8
+  #endif
+#endif
+
+#ifndef GATEWAY_MAX_PACKET_LENGTH
+  #if defined(__AVR__)
+    #define GATEWAY_MAX_PACKET_LENGTH                 64
+  #else
+    #define GATEWAY_MAX_PACKET_LENGTH                 255
+  #endif
+#endif
+
+#define GATEWAY_FREQ_TOLERANCE                        0.001       // channel match tolerance in MHz
+#define GATEWAY_EVENT_BATCH                           16          // number of GPIO events processed per service call
+#define GATEWAY_SERVICE_TIMEOUT                       100         // service thread wait timeout in ms
+
+/*!
+  \struct GatewayPacket
+
+  \brief Packet received by Gateway.
+*/
+struct GatewayPacket {
+  /*!
+    \brief Received payload.
+  */
+  uint8_t data[GATEWAY_MAX_PACKET_LENGTH];
+
+  /*!
+    \brief Payload length in bytes.
+  */
+  size_t len;
+
+  /*!
+    \brief Index of the radio that received the packet, in order of Gateway::addRadio calls.
+  */
+  uint8_t radio;
+
+  /*!
+    \brief Channel frequency in MHz.
+  */
+  float freq;
+
+  /*!
+    \brief Packet RSSI in dBm.
+  */
+  float rssi;
+
+  /*!
+    \brief Packet SNR in dB.
+  */
+  float snr;
+
+  /*!
+    \brief Timestamp of the end of packet in microseconds, same time base as Module::getMicros. Taken by kernel at interrupt time on Linux.
+  */
+  uint32_t timestamp;
+};
+
+/*!
+  \class Gateway
+
+  \brief Multi-radio gateway engine. Owns several SX127x modules, each listening continuously on its own channel with its own %LoRa profile.
+  Received packets from all radios are merged into a single queue ordered by timestamp, and transmit requests are routed to an idle radio
+  on the requested channel, which returns to reception when transmission is done.
+
+  On Linux, DIO0 lines of all radios are watched through GPIO character device, so the service waits for interrupts instead of polling,
+  and can run in its own thread (see Gateway::start). On other platforms, Gateway::service polls DIO0 pins and has to be called from the main loop.
+*/
+class Gateway {
+  public:
+    /*!
+      \brief Default constructor.
+    */
+    Gateway();
+
+#ifdef LINUX
+    /*!
+      \brief Default destructor, stops service thread.
+    */
+    ~Gateway();
+#endif
+
+    /*!
+      \brief Adds radio to the gateway. The radio has to be initialized in %LoRa mode (e.g. by calling begin) beforehand.
+
+      \param radio Pointer to radio module.
+
+      \param freq Channel frequency in MHz.
+
+      \param profile Modem settings and output power, built by SX127x::buildProfile.
+
+      \returns \ref status_codes
+    */
+    int16_t addRadio(SX127x* radio, float freq, const SX127xProfile& profile);
+
+    /*!
+      \brief Configures all radios and starts reception. DIO0 pins are polled by Gateway::service.
+
+      \returns \ref status_codes
+    */
+    int16_t begin();
+
+#ifdef LINUX
+    /*!
+      \brief Configures all radios and starts reception. DIO0 edges are read from GPIO character device. Only available on Linux.
+
+      \param chip Path to GPIO chip device, e.g. "/dev/gpiochip0".
+
+      \param dio0Lines Offsets of GPIO lines connected to DIO0 of each radio, in order of Gateway::addRadio calls.
+
+      \returns \ref status_codes
+    */
+    int16_t begin(const char* chip, const uint32_t* dio0Lines);
+
+    /*!
+      \brief Starts thread that calls Gateway::service. Requires DIO0 lines to be set in Gateway::begin. Only available on Linux.
+
+      \returns \ref status_codes
+    */
+    int16_t start();
+
+    /*!
+      \brief Stops service thread. Only available on Linux.
+    */
+    void stop();
+#endif
+
+    /*!
+      \brief Services radios: reads received packets into the queue and restarts reception after transmission.
+
+      \param timeout Maximum time to wait for interrupts in milliseconds, only used with GPIO character device on Linux. Defaults to 0.
+
+      \returns \ref status_codes
+    */
+    int16_t service(int timeout = 0);
+
+    /*!
+      \brief Gets number of received packets waiting in the queue.
+
+      \returns Number of packets.
+    */
+    size_t available();
+
+    /*!
+      \brief Reads the oldest received packet from the queue.
+
+      \param packet Pointer to structure to save the packet to.
+
+      \returns Whether a packet was read.
+    */
+    bool read(GatewayPacket* packet);
+
+    /*!
+      \brief Starts transmission on idle radio listening on the requested channel, using the profile of that radio.
+      Radio is idle when it is neither transmitting nor receiving a packet, i.e. no valid header was detected.
+      Packet that was already received by the radio is queued first. Transmission is finished by Gateway::service.
+
+      \param data Binary data that will be transmitted.
+
+      \param len Length of binary data to transmit (in bytes).
+
+      \param freq Channel frequency in MHz.
+
+      \returns \ref status_codes
+    */
+    int16_t transmit(uint8_t* data, size_t len, float freq);
+
+    /*!
+      \brief Gets number of received packets dropped because the queue was full or the packet was too long.
+
+      \returns Number of dropped packets.
+    */
+    uint32_t getDropped();
+
+    /*!
+      \brief Gets number of received packets that failed integrity check.
+
+      \returns Number of failed packets.
+    */
+    uint32_t getErrors();
+
+#ifndef RADIOLIB_GODMODE
+  private:
+#endif
+    struct GatewayRadio {
+      SX127x* radio;
+      float freq;
+      SX127xProfile profile;
+      bool transmitting;
+    };
+
+    GatewayRadio _radios[GATEWAY_MAX_RADIOS];
+    uint8_t _numRadios;
+
+    // received packets, ordered by timestamp
+    GatewayPacket _queue[GATEWAY_QUEUE_SIZE];
+    GatewayPacket _packet;
+    size_t _head;
+    size_t _count;
+
+    uint32_t _dropped;
+    uint32_t _errors;
+
+#ifdef LINUX
+    GPIOEvents _events;
+    uint32_t _eventsDropped;
+    std::mutex _mutex;
+    std::thread _thread;
+    std::atomic<bool> _running;
+
+    void run();
+#endif
+
+    int16_t configure();
+    void handle(uint8_t index, uint32_t timestamp);
+    void insert(const GatewayPacket& packet);
+};
+
+#endif
@@ -0,0 +1,69 @@
+#include "NoiseFloor.h"
+
+NoiseFloor::NoiseFloor(float alpha, float margin, uint8_t percentile) {
+  _alpha = alpha;
+  _margin = margin;
+  _percentile = percentile;
+  reset();
+}
+
+void NoiseFloor::reset() {
+  _average = 0;
+  _count = 0;
+  memset(_bins, 0x00, sizeof(_bins));
+}
+
+void NoiseFloor::addSample(float rssi) {
+  // first sample initializes the average
+  if(_count == 0) {
+    _average = rssi;
+  } else if(!isBusy(rssi)) {
+    // only samples that look like noise affect the average
+    _average += _alpha * (rssi - _average);
+  }
+
+  // find histogram bin
+  int16_t bin = (int16_t)((rssi - NOISE_FLOOR_BIN_LOW) / NOISE_FLOOR_BIN_WIDTH);
+  if(bin < 0) {
+    bin = 0;
+  } else if(bin >= NOISE_FLOOR_NUM_BINS) {
+    bin = NOISE_FLOOR_NUM_BINS - 1;
+  }
+
+  // age the histogram
+  if(_count >= NOISE_FLOOR_MAX_COUNT) {
+    _count = 0;
+    for(uint8_t i = 0; i < NOISE_FLOOR_NUM_BINS; i++) {
+      _bins[i] /= 2;
+      _count += _bins[i];
+    }
+  }
+
+  _bins[bin]++;
+  _count++;
+}
+
+float NoiseFloor::getPercentile(uint8_t percent) const {
+  if(_count == 0) {
+    return(_average);
+  }
+
+  // walk cumulative histogram and interpolate within the bin
+  float target = (float)_count * (float)percent / 100.0;
+  float cumulative = 0;
+  for(uint8_t i = 0; i < NOISE_FLOOR_NUM_BINS; i++) {
+    if((_bins[i] > 0) && (cumulative + _bins[i] >= target)) {
+      float fraction = (target - cumulative) / (float)_bins[i];
+      return(NOISE_FLOOR_BIN_LOW + ((float)i + fraction) * NOISE_FLOOR_BIN_WIDTH);
+    }
+    cumulative += _bins[i];
+  }
+  return(NOISE_FLOOR_BIN_LOW + NOISE_FLOOR_NUM_BINS * NOISE_FLOOR_BIN_WIDTH);
+}
+
+float NoiseFloor::getNoiseFloor() const {
+  if(_count < NOISE_FLOOR_MIN_SAMPLES) {
+    return(_average);
+  }
+  return(getPercentile(_percentile));
+}
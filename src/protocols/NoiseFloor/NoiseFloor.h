@@ -0,0 +1,106 @@
+#ifndef _RADIOLIB_NOISE_FLOOR_H
+#define _RADIOLIB_NOISE_FLOOR_H
+
+#include "../../TypeDef.h"
+
+// RSSI histogram
+#define NOISE_FLOOR_NUM_BINS                          32
+#define NOISE_FLOOR_BIN_LOW                           -160        // lower edge of the first bin in dBm
+#define NOISE_FLOOR_BIN_WIDTH                         3           // bin width in dB
+#define NOISE_FLOOR_MAX_COUNT                         1024        // histogram is halved when this many samples are collected, so that old samples fade out
+#define NOISE_FLOOR_MIN_SAMPLES                       16          // samples needed before histogram percentile is used
+
+// default busy threshold
+#define NOISE_FLOOR_PERCENTILE                        25          // histogram percentile taken as the noise floor
+#define NOISE_FLOOR_MARGIN                            6.0         // margin above noise floor in dB
+
+/*!
+  \class NoiseFloor
+
+  \brief Noise floor estimator of a single radio channel. RSSI samples (e.g. from SX127x::getCurrentRSSI while in receive mode)
+  are tracked by exponentially weighted moving average and a fixed-size histogram with aging. Busy threshold is a low percentile of the histogram
+  plus margin, so that occasional packets do not raise the floor. Use one instance per radio and channel.
+*/
+class NoiseFloor {
+  public:
+    /*!
+      \brief Default constructor.
+
+      \param alpha Weight of new samples in moving average. Allowed values are in range 0 to 1. Defaults to 0.05.
+
+      \param margin Margin above noise floor that is still considered free, in dB. Defaults to NOISE_FLOOR_MARGIN.
+
+      \param percentile Histogram percentile taken as the noise floor. Defaults to NOISE_FLOOR_PERCENTILE.
+    */
+    NoiseFloor(float alpha = 0.05, float margin = NOISE_FLOOR_MARGIN, uint8_t percentile = NOISE_FLOOR_PERCENTILE);
+
+    /*!
+      \brief Clears all collected samples.
+    */
+    void reset();
+
+    /*!
+      \brief Adds RSSI sample.
+
+      \param rssi RSSI in dBm.
+    */
+    void addSample(float rssi);
+
+    /*!
+      \brief Gets moving average of samples below the busy threshold.
+
+      \returns Average noise level in dBm.
+    */
+    float getAverage() const { return(_average); }
+
+    /*!
+      \brief Gets RSSI level below which the specified percentage of samples falls.
+
+      \param percent Percentile, allowed values are in range 0 to 100.
+
+      \returns Percentile in dBm.
+    */
+    float getPercentile(uint8_t percent) const;
+
+    /*!
+      \brief Gets estimated noise floor. Moving average is used until enough samples are collected, histogram percentile afterwards.
+
+      \returns Noise floor in dBm.
+    */
+    float getNoiseFloor() const;
+
+    /*!
+      \brief Gets adaptive busy threshold, e.g. for listen-before-talk or SX127x::setRSSIThreshold.
+
+      \returns Busy threshold in dBm.
+    */
+    float getThreshold() const { return(getNoiseFloor() + _margin); }
+
+    /*!
+      \brief Checks whether the channel is busy.
+
+      \param rssi Current RSSI in dBm.
+
+      \returns Whether the RSSI is above busy threshold.
+    */
+    bool isBusy(float rssi) const { return(rssi > getThreshold()); }
+
+    /*!
+      \brief Gets number of samples currently in the histogram.
+
+      \returns Number of samples.
+    */
+    uint16_t getNumSamples() const { return(_count); }
+
+#ifndef RADIOLIB_GODMODE
+  private:
+#endif
+    float _alpha;
+    float _margin;
+    uint8_t _percentile;
+    float _average;
+    uint16_t _count;
+    uint16_t _bins[NOISE_FLOOR_NUM_BINS];
+};
+
+#endif
@@ -0,0 +1,276 @@
+#include "OOKDecoder.h"
+
+const OOKProtocol OOKProtocolsDefault[OOK_PROTOCOLS_DEFAULT_NUM] = {
+  // name, encoding, short, long, gap, min bits, max bits
+  { "EV1527", OOK_ENCODING_PWM, 350, 1050, 5000, 24, 24 },
+  { "Nexus", OOK_ENCODING_PPM, 1000, 2000, 3500, 36, 36 },
+  { "Manchester", OOK_ENCODING_MANCHESTER, 500, 1000, 3500, 16, OOK_DECODER_MAX_BITS }
+};
+
+OOKDecoder* OOKDecoder::_instance = NULL;
+
+OOKDecoder::OOKDecoder(PhysicalLayer* phy) {
+  _phy = phy;
+  _protocols = NULL;
+  _numProtocols = 0;
+  _frameGap = 0;
+  _pin = RADIOLIB_NC;
+  _head = 0;
+  _tail = 0;
+  _dropped = 0;
+  _numPulses = 0;
+  _lastEdge = 0;
+  _frameStart = 0;
+}
+
+int16_t OOKDecoder::begin(RADIOLIB_PIN_TYPE pin, const OOKProtocol* protocols, uint8_t numProtocols) {
+  // set up decoder and enable direct mode
+  int16_t state = start(protocols, numProtocols);
+  RADIOLIB_ASSERT(state);
+
+  // timestamp both edges in interrupt
+  _pin = pin;
+  _instance = this;
+  attachInterrupt(digitalPinToInterrupt(_pin), OOKDecoder::edgeISR, CHANGE);
+
+  return(ERR_NONE);
+}
+
+#ifdef LINUX
+int16_t OOKDecoder::begin(const char* chip, uint32_t dataLine, const OOKProtocol* protocols, uint8_t numProtocols) {
+  // request the line first, so that the module is not switched to direct mode without it
+  uint8_t edges[] = { CHANGE };
+  int16_t state = _gpio.begin(chip, &dataLine, edges, 1);
+  RADIOLIB_ASSERT(state);
+
+  // set up decoder and enable direct mode
+  state = start(protocols, numProtocols);
+  if(state != ERR_NONE) {
+    _gpio.end();
+  }
+  return(state);
+}
+#endif
+
+void OOKDecoder::end() {
+  if(_pin != RADIOLIB_NC) {
+    detachInterrupt(digitalPinToInterrupt(_pin));
+    _pin = RADIOLIB_NC;
+  }
+  if(_instance == this) {
+    _instance = NULL;
+  }
+
+  #ifdef LINUX
+    _gpio.end();
+  #endif
+}
+
+bool OOKDecoder::decode(OOKFrame& frame) {
+  #ifdef LINUX
+    // move pending line events into the ring buffer, kernel timestamps are on the same clock as Module::getMicros
+    if(_gpio.getFd() >= 0) {
+      GPIOEvent events[32];
+      int num;
+      while((num = _gpio.read(events, 32, 0)) > 0) {
+        for(int i = 0; i < num; i++) {
+          pushEdge(events[i].timestamp / 1000, events[i].rising ? 1 : 0);
+        }
+      }
+    }
+  #endif
+
+  // convert edges to pulses
+  uint8_t lastLevel = (_numPulses % 2) ? 0 : 1;
+  while(_tail != _head) {
+    uint32_t timestamp = _edgeTime[_tail];
+    uint8_t level = _edgeLevel[_tail];
+    _tail = (_tail + 1) & (OOK_DECODER_RING_SIZE - 1);
+
+    // the pulse that ended at this edge had the opposite level
+    uint32_t duration = timestamp - _lastEdge;
+    _lastEdge = timestamp;
+    lastLevel = level;
+    if(addPulse(duration, !level, frame)) {
+      return(true);
+    }
+  }
+
+  // frame in progress and the signal has been low for long enough
+  if((_numPulses > 0) && (lastLevel == 0) && (Module::getMicros() - _lastEdge >= _frameGap)) {
+    return(finishFrame(frame));
+  }
+
+  return(false);
+}
+
+int16_t OOKDecoder::start(const OOKProtocol* protocols, uint8_t numProtocols) {
+  // check protocol table
+  if((protocols == NULL) || (numProtocols == 0)) {
+    return(ERR_UNKNOWN);
+  }
+
+  // frames are split at the shortest gap of all protocols
+  _protocols = protocols;
+  _numProtocols = numProtocols;
+  _frameGap = 0xFFFF;
+  for(uint8_t i = 0; i < _numProtocols; i++) {
+    if(_protocols[i].gapWidth < _frameGap) {
+      _frameGap = _protocols[i].gapWidth;
+    }
+  }
+
+  // reset buffers
+  _head = 0;
+  _tail = 0;
+  _dropped = 0;
+  _numPulses = 0;
+  _lastEdge = Module::getMicros();
+
+  // enable direct receive mode
+  return(_phy->receiveDirect());
+}
+
+void OOKDecoder::edgeISR() {
+  if(_instance != NULL) {
+    _instance->pushEdge(Module::getMicros(), Module::digitalRead(_instance->_pin));
+  }
+}
+
+void OOKDecoder::pushEdge(uint32_t timestamp, uint8_t level) {
+  uint16_t next = (_head + 1) & (OOK_DECODER_RING_SIZE - 1);
+  if(next == _tail) {
+    _dropped++;
+    return;
+  }
+  _edgeTime[_head] = timestamp;
+  _edgeLevel[_head] = level;
+  _head = next;
+}
+
+bool OOKDecoder::addPulse(uint32_t duration, uint8_t level, OOKFrame& frame) {
+  // long gap ends the frame
+  if((level == 0) && (duration >= _frameGap)) {
+    if(_numPulses > 0) {
+      return(finishFrame(frame));
+    }
+    return(false);
+  }
+
+  // frames start with high pulse
+  if(_numPulses == 0) {
+    if(level == 0) {
+      return(false);
+    }
+    _frameStart = _lastEdge - duration;
+  }
+
+  // pulses must alternate, otherwise an edge was missed
+  if((level == 1) != (_numPulses % 2 == 0)) {
+    _numPulses = 0;
+    return(false);
+  }
+
+  // discard frames that are too long
+  if(_numPulses >= OOK_DECODER_MAX_PULSES) {
+    _numPulses = 0;
+    return(false);
+  }
+
+  _pulses[_numPulses++] = (duration > 0xFFFF) ? 0xFFFF : duration;
+  return(false);
+}
+
+bool OOKDecoder::finishFrame(OOKFrame& frame) {
+  // try protocols in order
+  bool decoded = false;
+  for(uint8_t i = 0; i < _numProtocols; i++) {
+    uint16_t numBits = decodeFrame(&_protocols[i], frame.data);
+    if((numBits >= _protocols[i].minBits) && (numBits <= _protocols[i].maxBits)) {
+      frame.protocol = &_protocols[i];
+      frame.numBits = numBits;
+      frame.timestamp = _frameStart;
+      decoded = true;
+      break;
+    }
+  }
+
+  // start new frame
+  _numPulses = 0;
+  return(decoded);
+}
+
+uint16_t OOKDecoder::decodeFrame(const OOKProtocol* protocol, uint8_t* data) {
+  uint16_t numBits = 0;
+  memset(data, 0x00, OOK_DECODER_MAX_BITS / 8);
+
+  if(protocol->encoding == OOK_ENCODING_MANCHESTER) {
+    // the first bit may start with low half-bit that merged with the preceding gap, so try both alignments
+    for(uint8_t lead = 0; lead < 2; lead++) {
+      numBits = 0;
+      memset(data, 0x00, OOK_DECODER_MAX_BITS / 8);
+      uint16_t halfBits = lead;
+      uint8_t first = 0;
+      bool valid = true;
+
+      for(uint16_t i = 0; (i < _numPulses) && valid; i++) {
+        // each pulse is one or two half-bit periods long
+        uint8_t level = (i % 2 == 0) ? 1 : 0;
+        uint16_t num = (_pulses[i] + protocol->shortWidth/2) / protocol->shortWidth;
+        if((num < 1) || (num > 2)) {
+          valid = false;
+          break;
+        }
+
+        for(uint8_t j = 0; j < num; j++) {
+          if(halfBits % 2 == 0) {
+            first = level;
+          } else if((first == level) || (numBits >= OOK_DECODER_MAX_BITS)) {
+            valid = false;
+            break;
+          } else {
+            // low-to-high transition in the middle of bit period is 1
+            if(level) {
+              data[numBits / 8] |= (0x80 >> (numBits % 8));
+            }
+            numBits++;
+          }
+          halfBits++;
+        }
+      }
+
+      // last bit may end with low half-bit that merged with the following gap
+      if(valid && (halfBits % 2 == 1) && (first == 1) && (numBits < OOK_DECODER_MAX_BITS)) {
+        numBits++;
+      } else if(halfBits % 2 == 1) {
+        valid = false;
+      }
+
+      if(valid) {
+        return(numBits);
+      }
+    }
+    return(0);
+  }
+
+  // PWM bits are in high pulses (even indices), PPM bits in the gaps between them (odd indices)
+  uint16_t i = (protocol->encoding == OOK_ENCODING_PWM) ? 0 : 1;
+  uint16_t threshold = (protocol->shortWidth + protocol->longWidth) / 2;
+  uint16_t numPulses = _numPulses;
+  if((protocol->encoding == OOK_ENCODING_PWM) && (numPulses == 2*protocol->maxBits + 1)) {
+    // stop/sync pulse following the last bit
+    numPulses--;
+  }
+  for(; i < numPulses; i += 2) {
+    // reject pulses outside the expected range
+    if((_pulses[i] < protocol->shortWidth/2) || (_pulses[i] > protocol->longWidth + protocol->longWidth/2) || (numBits >= OOK_DECODER_MAX_BITS)) {
+      return(0);
+    }
+    if(_pulses[i] > threshold) {
+      data[numBits / 8] |= (0x80 >> (numBits % 8));
+    }
+    numBits++;
+  }
+
+  return(numBits);
+}
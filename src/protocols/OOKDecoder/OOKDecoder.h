@@ -0,0 +1,218 @@
+#ifndef _RADIOLIB_OOK_DECODER_H
+#define _RADIOLIB_OOK_DECODER_H
+
+#include "../../TypeDef.h"
+#include "../../Module.h"
+#include "../PhysicalLayer/PhysicalLayer.h"
+
+#ifdef LINUX
+#include "../../linux-workarounds/GPIO/GPIOEvents.h"
+#endif
+
+// edge ring buffer size, must be a power of 2
+#ifndef OOK_DECODER_RING_SIZE
+  #if defined(__AVR__)
+    #define OOK_DECODER_RING_SIZE                     64
+  #else
+    #define OOK_DECODER_RING_SIZE                     256
+  #endif
+#endif
+
+// maximum number of bits in a single frame
+#ifndef OOK_DECODER_MAX_BITS
+  #if defined(__AVR__)
+    #define OOK_DECODER_MAX_BITS                      64
+  #else
+    #define OOK_DECODER_MAX_BITS                      128
+  #endif
+#endif
+
+#define OOK_DECODER_MAX_PULSES                        (2*OOK_DECODER_MAX_BITS + 2)
+
+// pulse encodings
+#define OOK_ENCODING_PWM                              0x00  // bit value in high pulse width: long = 1, short = 0
+#define OOK_ENCODING_PPM                              0x01  // bit value in gap width between pulses: long = 1, short = 0
+#define OOK_ENCODING_MANCHESTER                       0x02  // IEEE 802.3 Manchester: low-to-high transition = 1, half-bit period is the short pulse
+
+// number of built-in protocols in OOKProtocolsDefault
+#define OOK_PROTOCOLS_DEFAULT_NUM                     3
+
+/*!
+  \struct OOKProtocol
+
+  \brief Pulse timing descriptor of OOK sensor/remote encoding.
+*/
+struct OOKProtocol {
+  /*!
+    \brief Protocol name.
+  */
+  const char* name;
+
+  /*!
+    \brief Pulse encoding, one of OOK_ENCODING_* values.
+  */
+  uint8_t encoding;
+
+  /*!
+    \brief Nominal short pulse/gap width in microseconds. Half-bit period for Manchester.
+  */
+  uint16_t shortWidth;
+
+  /*!
+    \brief Nominal long pulse/gap width in microseconds. Unused for Manchester.
+  */
+  uint16_t longWidth;
+
+  /*!
+    \brief Shortest gap in microseconds that ends a frame.
+  */
+  uint16_t gapWidth;
+
+  /*!
+    \brief Minimum number of bits in a valid frame.
+  */
+  uint8_t minBits;
+
+  /*!
+    \brief Maximum number of bits in a valid frame.
+  */
+  uint8_t maxBits;
+};
+
+/*!
+  \brief Built-in protocol table: EV1527/PT2262-style remotes (PWM), Nexus-style temperature sensors (PPM) and generic 1 kbps Manchester.
+*/
+extern const OOKProtocol OOKProtocolsDefault[OOK_PROTOCOLS_DEFAULT_NUM];
+
+/*!
+  \struct OOKFrame
+
+  \brief Decoded OOK frame.
+*/
+struct OOKFrame {
+  /*!
+    \brief Protocol the frame was decoded with.
+  */
+  const OOKProtocol* protocol;
+
+  /*!
+    \brief Frame bits, packed MSB first.
+  */
+  uint8_t data[OOK_DECODER_MAX_BITS / 8];
+
+  /*!
+    \brief Number of decoded bits.
+  */
+  uint16_t numBits;
+
+  /*!
+    \brief Timestamp of the first edge of the frame, as returned by Module::getMicros.
+  */
+  uint32_t timestamp;
+};
+
+/*!
+  \class OOKDecoder
+
+  \brief Decoder of pulse-timed OOK transmissions (cheap 433 MHz sensors and remotes) received in direct mode.
+  Edges on DIO2 are timestamped into a ring buffer, either by pin change interrupt or by Linux GPIO line events,
+  split into frames on long gaps and classified by a table of OOKProtocol descriptors.
+*/
+class OOKDecoder {
+  public:
+    /*!
+      \brief Default constructor.
+
+      \param phy Pointer to the wireless module providing PhysicalLayer communication. OOK modulation must already be enabled, e.g. by SX127x::setOOK.
+    */
+    OOKDecoder(PhysicalLayer* phy);
+
+    /*!
+      \brief Switches the module to direct receive mode and starts timestamping DIO2 edges using pin change interrupt.
+      Only one instance can use interrupts at a time.
+
+      \param pin Pin connected to DIO2, must support pin change interrupts.
+
+      \param protocols Protocol table to decode frames with. Tried in order, first match is used.
+
+      \param numProtocols Number of entries in protocol table.
+
+      \returns \ref status_codes
+    */
+    int16_t begin(RADIOLIB_PIN_TYPE pin, const OOKProtocol* protocols = OOKProtocolsDefault, uint8_t numProtocols = OOK_PROTOCOLS_DEFAULT_NUM);
+
+#ifdef LINUX
+    /*!
+      \brief Switches the module to direct receive mode and starts timestamping DIO2 edges using GPIO character device.
+
+      \param chip Path to GPIO chip device, e.g. "/dev/gpiochip0".
+
+      \param dataLine Offset of the GPIO line connected to DIO2.
+
+      \param protocols Protocol table to decode frames with. Tried in order, first match is used.
+
+      \param numProtocols Number of entries in protocol table.
+
+      \returns \ref status_codes
+    */
+    int16_t begin(const char* chip, uint32_t dataLine, const OOKProtocol* protocols = OOKProtocolsDefault, uint8_t numProtocols = OOK_PROTOCOLS_DEFAULT_NUM);
+#endif
+
+    /*!
+      \brief Stops edge timestamping.
+    */
+    void end();
+
+    /*!
+      \brief Processes timestamped edges. Should be called periodically, at least once per frame.
+
+      \param frame Structure to save decoded frame to.
+
+      \returns Whether a frame was decoded.
+    */
+    bool decode(OOKFrame& frame);
+
+    /*!
+      \brief Gets number of edges lost because the ring buffer was full.
+
+      \returns Number of lost edges.
+    */
+    uint32_t getDropped() const { return(_dropped); }
+
+#ifndef RADIOLIB_GODMODE
+  private:
+#endif
+    PhysicalLayer* _phy;
+    const OOKProtocol* _protocols;
+    uint8_t _numProtocols;
+    uint16_t _frameGap;
+    RADIOLIB_PIN_TYPE _pin;
+
+    // edge ring buffer, written by interrupt or GPIO event reader
+    volatile uint32_t _edgeTime[OOK_DECODER_RING_SIZE];
+    volatile uint8_t _edgeLevel[OOK_DECODER_RING_SIZE];
+    volatile uint16_t _head;
+    volatile uint16_t _tail;
+    volatile uint32_t _dropped;
+
+    // pulse train of the frame being received, starting with high pulse
+    uint16_t _pulses[OOK_DECODER_MAX_PULSES];
+    uint16_t _numPulses;
+    uint32_t _lastEdge;
+    uint32_t _frameStart;
+
+#ifdef LINUX
+    GPIOEvents _gpio;
+#endif
+
+    static OOKDecoder* _instance;
+    static void edgeISR();
+
+    int16_t start(const OOKProtocol* protocols, uint8_t numProtocols);
+    void pushEdge(uint32_t timestamp, uint8_t level);
+    bool addPulse(uint32_t duration, uint8_t level, OOKFrame& frame);
+    bool finishFrame(OOKFrame& frame);
+    uint16_t decodeFrame(const OOKProtocol* protocol, uint8_t* data);
+};
+
+#endif
@@ -0,0 +1,154 @@
+// intrinsics headers have to be included before TypeDef.h redefines some standard functions
+#if defined(LINUX) && (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+  #include <wmmintrin.h>
+  #include <cpuid.h>
+  #define AES128_HW_AESNI
+#elif defined(LINUX) && defined(__aarch64__) && (defined(__ARM_FEATURE_AES) || defined(__ARM_FEATURE_CRYPTO))
+  #include <arm_neon.h>
+  #define AES128_HW_ARMV8
+#endif
+
+#include "AES128.h"
+
+static const uint8_t AES128_SBOX[256] PROGMEM = {
+  0x63, 0x7C, 0x77, 0x7B, 0xF2, 0x6B, 0x6F, 0xC5, 0x30, 0x01, 0x67, 0x2B, 0xFE, 0xD7, 0xAB, 0x76,
+  0xCA, 0x82, 0xC9, 0x7D, 0xFA, 0x59, 0x47, 0xF0, 0xAD, 0xD4, 0xA2, 0xAF, 0x9C, 0xA4, 0x72, 0xC0,
+  0xB7, 0xFD, 0x93, 0x26, 0x36, 0x3F, 0xF7, 0xCC, 0x34, 0xA5, 0xE5, 0xF1, 0x71, 0xD8, 0x31, 0x15,
+  0x04, 0xC7, 0x23, 0xC3, 0x18, 0x96, 0x05, 0x9A, 0x07, 0x12, 0x80, 0xE2, 0xEB, 0x27, 0xB2, 0x75,
+  0x09, 0x83, 0x2C, 0x1A, 0x1B, 0x6E, 0x5A, 0xA0, 0x52, 0x3B, 0xD6, 0xB3, 0x29, 0xE3, 0x2F, 0x84,
+  0x53, 0xD1, 0x00, 0xED, 0x20, 0xFC, 0xB1, 0x5B, 0x6A, 0xCB, 0xBE, 0x39, 0x4A, 0x4C, 0x58, 0xCF,
+  0xD0, 0xEF, 0xAA, 0xFB, 0x43, 0x4D, 0x33, 0x85, 0x45, 0xF9, 0x02, 0x7F, 0x50, 0x3C, 0x9F, 0xA8,
+  0x51, 0xA3, 0x40, 0x8F, 0x92, 0x9D, 0x38, 0xF5, 0xBC, 0xB6, 0xDA, 0x21, 0x10, 0xFF, 0xF3, 0xD2,
+  0xCD, 0x0C, 0x13, 0xEC, 0x5F, 0x97, 0x44, 0x17, 0xC4, 0xA7, 0x7E, 0x3D, 0x64, 0x5D, 0x19, 0x73,
+  0x60, 0x81, 0x4F, 0xDC, 0x22, 0x2A, 0x90, 0x88, 0x46, 0xEE, 0xB8, 0x14, 0xDE, 0x5E, 0x0B, 0xDB,
+  0xE0, 0x32, 0x3A, 0x0A, 0x49, 0x06, 0x24, 0x5C, 0xC2, 0xD3, 0xAC, 0x62, 0x91, 0x95, 0xE4, 0x79,
+  0xE7, 0xC8, 0x37, 0x6D, 0x8D, 0xD5, 0x4E, 0xA9, 0x6C, 0x56, 0xF4, 0xEA, 0x65, 0x7A, 0xAE, 0x08,
+  0xBA, 0x78, 0x25, 0x2E, 0x1C, 0xA6, 0xB4, 0xC6, 0xE8, 0xDD, 0x74, 0x1F, 0x4B, 0xBD, 0x8B, 0x8A,
+  0x70, 0x3E, 0xB5, 0x66, 0x48, 0x03, 0xF6, 0x0E, 0x61, 0x35, 0x57, 0xB9, 0x86, 0xC1, 0x1D, 0x9E,
+  0xE1, 0xF8, 0x98, 0x11, 0x69, 0xD9, 0x8E, 0x94, 0x9B, 0x1E, 0x87, 0xE9, 0xCE, 0x55, 0x28, 0xDF,
+  0x8C, 0xA1, 0x89, 0x0D, 0xBF, 0xE6, 0x42, 0x68, 0x41, 0x99, 0x2D, 0x0F, 0xB0, 0x54, 0xBB, 0x16
+};
+
+// multiplication by x in GF(2^8)
+#define AES128_XTIME(x)                               ((uint8_t)(((x) << 1) ^ (((x) & 0x80) ? 0x1B : 0x00)))
+
+#if defined(AES128_HW_AESNI)
+// compiled for AES-NI regardless of global compiler flags, only called after CPU support was checked
+__attribute__((target("aes,sse2")))
+static void AES128_encryptAESNI(const uint8_t* roundKeys, const uint8_t* in, uint8_t* out) {
+  __m128i block = _mm_loadu_si128((const __m128i*)in);
+  block = _mm_xor_si128(block, _mm_loadu_si128((const __m128i*)roundKeys));
+  for(uint8_t round = 1; round < AES128_ROUNDS; round++) {
+    block = _mm_aesenc_si128(block, _mm_loadu_si128((const __m128i*)(roundKeys + round * AES128_BLOCK_SIZE)));
+  }
+  block = _mm_aesenclast_si128(block, _mm_loadu_si128((const __m128i*)(roundKeys + AES128_ROUNDS * AES128_BLOCK_SIZE)));
+  _mm_storeu_si128((__m128i*)out, block);
+}
+#elif defined(AES128_HW_ARMV8)
+static void AES128_encryptARMv8(const uint8_t* roundKeys, const uint8_t* in, uint8_t* out) {
+  // AESE performs AddRoundKey, SubBytes and ShiftRows, AESMC performs MixColumns
+  uint8x16_t block = vld1q_u8(in);
+  for(uint8_t round = 0; round < AES128_ROUNDS - 1; round++) {
+    block = vaesmcq_u8(vaeseq_u8(block, vld1q_u8(roundKeys + round * AES128_BLOCK_SIZE)));
+  }
+  block = vaeseq_u8(block, vld1q_u8(roundKeys + (AES128_ROUNDS - 1) * AES128_BLOCK_SIZE));
+  block = veorq_u8(block, vld1q_u8(roundKeys + AES128_ROUNDS * AES128_BLOCK_SIZE));
+  vst1q_u8(out, block);
+}
+#endif
+
+AES128::AES128() {
+  memset(_roundKeys, 0x00, sizeof(_roundKeys));
+  _hardware = hardwareAvailable();
+}
+
+void AES128::setKey(const uint8_t* key) {
+  // the first round key is the key itself
+  memcpy(_roundKeys, key, AES128_KEY_SIZE);
+
+  uint8_t rcon = 0x01;
+  for(uint8_t i = AES128_KEY_SIZE; i < sizeof(_roundKeys); i += 4) {
+    uint8_t word[4];
+    memcpy(word, _roundKeys + i - 4, 4);
+
+    // at the start of each round key, rotate, substitute and add round constant
+    if(i % AES128_KEY_SIZE == 0) {
+      uint8_t first = word[0];
+      word[0] = pgm_read_byte(&AES128_SBOX[word[1]]) ^ rcon;
+      word[1] = pgm_read_byte(&AES128_SBOX[word[2]]);
+      word[2] = pgm_read_byte(&AES128_SBOX[word[3]]);
+      word[3] = pgm_read_byte(&AES128_SBOX[first]);
+      rcon = AES128_XTIME(rcon);
+    }
+
+    for(uint8_t j = 0; j < 4; j++) {
+      _roundKeys[i + j] = _roundKeys[i + j - AES128_KEY_SIZE] ^ word[j];
+    }
+  }
+}
+
+void AES128::encryptBlock(const uint8_t* in, uint8_t* out) {
+#if defined(AES128_HW_AESNI)
+  if(_hardware) {
+    AES128_encryptAESNI(_roundKeys, in, out);
+    return;
+  }
+#elif defined(AES128_HW_ARMV8)
+  AES128_encryptARMv8(_roundKeys, in, out);
+  return;
+#endif
+  encryptSoftware(in, out);
+}
+
+void AES128::encryptSoftware(const uint8_t* in, uint8_t* out) {
+  // state is stored column by column, as in the input block
+  uint8_t state[AES128_BLOCK_SIZE];
+  for(uint8_t i = 0; i < AES128_BLOCK_SIZE; i++) {
+    state[i] = in[i] ^ _roundKeys[i];
+  }
+
+  for(uint8_t round = 1; round <= AES128_ROUNDS; round++) {
+    // SubBytes and ShiftRows, row r is rotated left by r columns
+    uint8_t tmp[AES128_BLOCK_SIZE];
+    for(uint8_t c = 0; c < 4; c++) {
+      for(uint8_t r = 0; r < 4; r++) {
+        tmp[c*4 + r] = pgm_read_byte(&AES128_SBOX[state[((c + r) & 0x03)*4 + r]]);
+      }
+    }
+
+    // MixColumns, skipped in the last round
+    if(round < AES128_ROUNDS) {
+      for(uint8_t c = 0; c < 4; c++) {
+        uint8_t* col = tmp + c*4;
+        uint8_t a0 = col[0], a1 = col[1], a2 = col[2], a3 = col[3];
+        uint8_t all = a0 ^ a1 ^ a2 ^ a3;
+        col[0] = a0 ^ all ^ AES128_XTIME(a0 ^ a1);
+        col[1] = a1 ^ all ^ AES128_XTIME(a1 ^ a2);
+        col[2] = a2 ^ all ^ AES128_XTIME(a2 ^ a3);
+        col[3] = a3 ^ all ^ AES128_XTIME(a3 ^ a0);
+      }
+    }
+
+    // AddRoundKey
+    const uint8_t* roundKey = _roundKeys + round * AES128_BLOCK_SIZE;
+    for(uint8_t i = 0; i < AES128_BLOCK_SIZE; i++) {
+      state[i] = tmp[i] ^ roundKey[i];
+    }
+  }
+
+  memcpy(out, state, AES128_BLOCK_SIZE);
+}
+
+bool AES128::hardwareAvailable() {
+#if defined(AES128_HW_AESNI)
+  unsigned int eax, ebx, ecx, edx;
+  if(!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+    return(false);
+  }
+  return((ecx & bit_AES) && (edx & bit_SSE2));
+#elif defined(AES128_HW_ARMV8)
+  return(true);
+#else
+  return(false);
+#endif
+}
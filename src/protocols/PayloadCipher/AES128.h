@@ -0,0 +1,50 @@
+#ifndef _RADIOLIB_AES128_H
+#define _RADIOLIB_AES128_H
+
+#include "../../TypeDef.h"
+
+#define AES128_BLOCK_SIZE                             16
+#define AES128_KEY_SIZE                               16
+#define AES128_ROUNDS                                 10
+
+/*!
+  \class AES128
+
+  \brief AES-128 block cipher, encryption direction only (sufficient for CTR mode and CMAC). Key schedule is expanded once in setKey,
+  so that encrypting a block only needs table lookups from program memory. On Linux x86, AES-NI instructions are used when the CPU supports them;
+  on AArch64, ARMv8 crypto extensions are used when enabled by compiler flags.
+*/
+class AES128 {
+  public:
+    /*!
+      \brief Default constructor.
+    */
+    AES128();
+
+    /*!
+      \brief Sets key and computes key schedule.
+
+      \param key 16-byte key.
+    */
+    void setKey(const uint8_t* key);
+
+    /*!
+      \brief Encrypts single block.
+
+      \param in 16-byte input block.
+
+      \param out 16-byte output block, may be the same as input.
+    */
+    void encryptBlock(const uint8_t* in, uint8_t* out);
+
+#ifndef RADIOLIB_GODMODE
+  private:
+#endif
+    uint8_t _roundKeys[AES128_BLOCK_SIZE * (AES128_ROUNDS + 1)];
+    bool _hardware;
+
+    void encryptSoftware(const uint8_t* in, uint8_t* out);
+    static bool hardwareAvailable();
+};
+
+#endif
@@ -0,0 +1,175 @@
+#include "AESCipher.h"
+
+AESCipher::AESCipher() {
+  memset(_nonce, 0x00, AES_CIPHER_NONCE_LENGTH);
+  _txCounter = 0;
+  _rxCounter = 0;
+  _packetCounter = 0;
+  _keystreamPos = AES128_BLOCK_SIZE;
+  _macPos = 0;
+  memset(_k1, 0x00, AES128_BLOCK_SIZE);
+  memset(_k2, 0x00, AES128_BLOCK_SIZE);
+}
+
+void AESCipher::setKeys(const uint8_t* encKey, const uint8_t* macKey) {
+  _enc.setKey(encKey);
+  _mac.setKey(macKey);
+
+  // CMAC subkeys are derived from encrypted zero block
+  uint8_t l[AES128_BLOCK_SIZE];
+  memset(l, 0x00, AES128_BLOCK_SIZE);
+  _mac.encryptBlock(l, l);
+  shiftSubkey(l, _k1);
+  shiftSubkey(_k1, _k2);
+}
+
+void AESCipher::setNonce(const uint8_t* nonce) {
+  memcpy(_nonce, nonce, AES_CIPHER_NONCE_LENGTH);
+}
+
+void AESCipher::setFrameCounter(uint32_t counter) {
+  _txCounter = counter;
+}
+
+uint32_t AESCipher::getFrameCounter() {
+  return(_txCounter);
+}
+
+void AESCipher::setRxFrameCounter(uint32_t counter) {
+  _rxCounter = counter;
+}
+
+uint8_t AESCipher::getHeaderLength() {
+  return(AES_CIPHER_HEADER_LENGTH);
+}
+
+uint8_t AESCipher::getTagLength() {
+  return(AES_CIPHER_MIC_LENGTH);
+}
+
+void AESCipher::beginEncrypt(uint8_t* header) {
+  // frame counter is big endian
+  uint32_t counter = _txCounter++;
+  for(uint8_t i = 0; i < AES_CIPHER_HEADER_LENGTH; i++) {
+    header[i] = (counter >> (8 * (AES_CIPHER_HEADER_LENGTH - 1 - i))) & 0xFF;
+  }
+  start(counter);
+  macUpdate(header, AES_CIPHER_HEADER_LENGTH);
+}
+
+void AESCipher::encrypt(uint8_t* data, size_t len) {
+  process(data, len, true);
+}
+
+void AESCipher::finishEncrypt(uint8_t* tag) {
+  uint8_t mac[AES128_BLOCK_SIZE];
+  macFinish(mac);
+  memcpy(tag, mac, AES_CIPHER_MIC_LENGTH);
+}
+
+void AESCipher::beginDecrypt(const uint8_t* header) {
+  uint32_t counter = 0;
+  for(uint8_t i = 0; i < AES_CIPHER_HEADER_LENGTH; i++) {
+    counter = (counter << 8) | header[i];
+  }
+  start(counter);
+  macUpdate(header, AES_CIPHER_HEADER_LENGTH);
+}
+
+void AESCipher::decrypt(uint8_t* data, size_t len) {
+  process(data, len, false);
+}
+
+bool AESCipher::finishDecrypt(const uint8_t* tag) {
+  uint8_t mac[AES128_BLOCK_SIZE];
+  macFinish(mac);
+
+  // compare without early exit
+  uint8_t diff = 0;
+  for(uint8_t i = 0; i < AES_CIPHER_MIC_LENGTH; i++) {
+    diff |= mac[i] ^ tag[i];
+  }
+  if((diff != 0) || (_packetCounter < _rxCounter)) {
+    return(false);
+  }
+
+  // only authentic packets move the replay window
+  _rxCounter = _packetCounter + 1;
+  return(true);
+}
+
+void AESCipher::start(uint32_t counter) {
+  _packetCounter = counter;
+
+  // counter block: nonce, frame counter, block counter
+  memcpy(_counterBlock, _nonce, AES_CIPHER_NONCE_LENGTH);
+  for(uint8_t i = 0; i < 4; i++) {
+    _counterBlock[AES_CIPHER_NONCE_LENGTH + i] = (counter >> (24 - 8*i)) & 0xFF;
+    _counterBlock[AES_CIPHER_NONCE_LENGTH + 4 + i] = 0x00;
+  }
+  _keystreamPos = AES128_BLOCK_SIZE;
+
+  // authenticated data starts with the nonce
+  memset(_macState, 0x00, AES128_BLOCK_SIZE);
+  _macPos = 0;
+  macUpdate(_nonce, AES_CIPHER_NONCE_LENGTH);
+}
+
+void AESCipher::process(uint8_t* data, size_t len, bool encrypting) {
+  for(size_t i = 0; i < len; i++) {
+    // next keystream block, the two lowest bytes of block counter are enough for any packet
+    if(_keystreamPos == AES128_BLOCK_SIZE) {
+      _counterBlock[AES128_BLOCK_SIZE - 1]++;
+      if(_counterBlock[AES128_BLOCK_SIZE - 1] == 0) {
+        _counterBlock[AES128_BLOCK_SIZE - 2]++;
+      }
+      _enc.encryptBlock(_counterBlock, _keystream);
+      _keystreamPos = 0;
+    }
+
+    // MAC is computed over ciphertext
+    if(encrypting) {
+      data[i] ^= _keystream[_keystreamPos++];
+      macUpdate(data + i, 1);
+    } else {
+      macUpdate(data + i, 1);
+      data[i] ^= _keystream[_keystreamPos++];
+    }
+  }
+}
+
+void AESCipher::macUpdate(const uint8_t* data, size_t len) {
+  for(size_t i = 0; i < len; i++) {
+    // full block is only processed once more data arrives, the last block is handled by macFinish
+    if(_macPos == AES128_BLOCK_SIZE) {
+      _mac.encryptBlock(_macState, _macState);
+      _macPos = 0;
+    }
+    _macState[_macPos++] ^= data[i];
+  }
+}
+
+void AESCipher::macFinish(uint8_t* tag) {
+  // complete last block uses K1, padded last block uses K2
+  const uint8_t* subkey = _k1;
+  if(_macPos < AES128_BLOCK_SIZE) {
+    _macState[_macPos] ^= 0x80;
+    subkey = _k2;
+  }
+  for(uint8_t i = 0; i < AES128_BLOCK_SIZE; i++) {
+    _macState[i] ^= subkey[i];
+  }
+  _mac.encryptBlock(_macState, tag);
+}
+
+void AESCipher::shiftSubkey(const uint8_t* in, uint8_t* out) {
+  // left shift by one bit, reduce by x^128 + x^7 + x^2 + x + 1
+  uint8_t carry = in[0] & 0x80;
+  for(uint8_t i = 0; i < AES128_BLOCK_SIZE - 1; i++) {
+    out[i] = (in[i] << 1) | (in[i + 1] >> 7);
+  }
+  out[AES128_BLOCK_SIZE - 1] = in[AES128_BLOCK_SIZE - 1] << 1;
+  if(carry) {
+    out[AES128_BLOCK_SIZE - 1] ^= 0x87;
+  }
+}
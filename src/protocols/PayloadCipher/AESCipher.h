@@ -0,0 +1,109 @@
+#ifndef _RADIOLIB_AES_CIPHER_H
+#define _RADIOLIB_AES_CIPHER_H
+
+#include "../../TypeDef.h"
+#include "PayloadCipher.h"
+#include "AES128.h"
+
+// packet header is the frame counter, sent in plain text
+#define AES_CIPHER_HEADER_LENGTH                      4
+
+// link nonce, together with frame counter forms CTR initial counter block
+#define AES_CIPHER_NONCE_LENGTH                       8
+
+// message integrity code, truncated CMAC
+#ifndef AES_CIPHER_MIC_LENGTH
+  #define AES_CIPHER_MIC_LENGTH                       4
+#endif
+
+/*!
+  \class AESCipher
+
+  \brief AES-128 payload security stage. Payload is encrypted in CTR mode and authenticated with AES-CMAC (RFC 4493) computed over
+  link nonce, frame counter and ciphertext, truncated to AES_CIPHER_MIC_LENGTH bytes. Each packet carries 4-byte frame counter,
+  which must never repeat for the same key and nonce - save the value from getFrameCounter and restore it after reset.
+  Receiver rejects frame counters that are lower than the last authentic one.
+*/
+class AESCipher: public PayloadCipher {
+  public:
+    /*!
+      \brief Default constructor.
+    */
+    AESCipher();
+
+    /*!
+      \brief Sets keys. Separate keys should be used for encryption and authentication.
+
+      \param encKey 16-byte encryption key.
+
+      \param macKey 16-byte authentication key.
+    */
+    void setKeys(const uint8_t* encKey, const uint8_t* macKey);
+
+    /*!
+      \brief Sets link nonce, e.g. transmitter address. Must be the same on both sides.
+
+      \param nonce 8-byte nonce.
+    */
+    void setNonce(const uint8_t* nonce);
+
+    /*!
+      \brief Sets frame counter of the next transmitted packet.
+
+      \param counter Frame counter.
+    */
+    void setFrameCounter(uint32_t counter);
+
+    /*!
+      \brief Gets frame counter of the next transmitted packet.
+
+      \returns Frame counter.
+    */
+    uint32_t getFrameCounter();
+
+    /*!
+      \brief Sets the lowest frame counter that will be accepted by receiver.
+
+      \param counter Frame counter.
+    */
+    void setRxFrameCounter(uint32_t counter);
+
+    // PayloadCipher methods
+    uint8_t getHeaderLength();
+    uint8_t getTagLength();
+    void beginEncrypt(uint8_t* header);
+    void encrypt(uint8_t* data, size_t len);
+    void finishEncrypt(uint8_t* tag);
+    void beginDecrypt(const uint8_t* header);
+    void decrypt(uint8_t* data, size_t len);
+    bool finishDecrypt(const uint8_t* tag);
+
+#ifndef RADIOLIB_GODMODE
+  private:
+#endif
+    AES128 _enc;
+    AES128 _mac;
+    uint8_t _nonce[AES_CIPHER_NONCE_LENGTH];
+    uint32_t _txCounter;
+    uint32_t _rxCounter;
+    uint32_t _packetCounter;
+
+    // CTR mode
+    uint8_t _counterBlock[AES128_BLOCK_SIZE];
+    uint8_t _keystream[AES128_BLOCK_SIZE];
+    uint8_t _keystreamPos;
+
+    // CMAC subkeys and running state
+    uint8_t _k1[AES128_BLOCK_SIZE];
+    uint8_t _k2[AES128_BLOCK_SIZE];
+    uint8_t _macState[AES128_BLOCK_SIZE];
+    uint8_t _macPos;
+
+    void start(uint32_t counter);
+    void process(uint8_t* data, size_t len, bool encrypting);
+    void macUpdate(const uint8_t* data, size_t len);
+    void macFinish(uint8_t* tag);
+    static void shiftSubkey(const uint8_t* in, uint8_t* out);
+};
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef _RADIOLIB_PAYLOAD_CIPHER_H
+#define _RADIOLIB_PAYLOAD_CIPHER_H
+
+#include "../../TypeDef.h"
+
+// maximum length of header or tag added by cipher
+#define PAYLOAD_CIPHER_MAX_OVERHEAD                   16
+
+/*!
+  \class PayloadCipher
+
+  \brief Interface for payload security stage applied by the module driver while payload is moved between user buffer and module FIFO.
+  Each packet is framed as header, payload and tag. Payload is passed in chunks, so that encryption and authentication are done
+  in the same pass as the SPI transfer, without a second payload-sized buffer.
+*/
+class PayloadCipher {
+  public:
+    /*!
+      \brief Gets length of the header sent before payload.
+
+      \returns Header length in bytes, at most PAYLOAD_CIPHER_MAX_OVERHEAD.
+    */
+    virtual uint8_t getHeaderLength() = 0;
+
+    /*!
+      \brief Gets length of the tag sent after payload.
+
+      \returns Tag length in bytes, at most PAYLOAD_CIPHER_MAX_OVERHEAD.
+    */
+    virtual uint8_t getTagLength() = 0;
+
+    /*!
+      \brief Starts encryption of a new packet.
+
+      \param header Pointer to array to save the packet header to.
+    */
+    virtual void beginEncrypt(uint8_t* header) = 0;
+
+    /*!
+      \brief Encrypts the next chunk of payload in place.
+
+      \param data Chunk of payload.
+
+      \param len Length of chunk in bytes.
+    */
+    virtual void encrypt(uint8_t* data, size_t len) = 0;
+
+    /*!
+      \brief Finishes encryption of packet.
+
+      \param tag Pointer to array to save the packet tag to.
+    */
+    virtual void finishEncrypt(uint8_t* tag) = 0;
+
+    /*!
+      \brief Starts decryption of received packet.
+
+      \param header Received packet header.
+    */
+    virtual void beginDecrypt(const uint8_t* header) = 0;
+
+    /*!
+      \brief Decrypts the next chunk of payload in place.
+
+      \param data Chunk of payload.
+
+      \param len Length of chunk in bytes.
+    */
+    virtual void decrypt(uint8_t* data, size_t len) = 0;
+
+    /*!
+      \brief Finishes decryption of packet and verifies its tag.
+
+      \param tag Received packet tag.
+
+      \returns Whether the packet is authentic.
+    */
+    virtual bool finishDecrypt(const uint8_t* tag) = 0;
+};
+
+#endif
@@ -94,6 +94,19 @@ class PhysicalLayer {
     */
     virtual int16_t receive(uint8_t* data, size_t len) = 0;
 
+    /*!
+      \brief Binary receive method with timeout. Must be implemented in module class.
+
+      \param data Pointer to array to save the received binary data.
+
+      \param len Number of bytes that will be received. Must be known in advance for binary transmissions.
+
+      \param timeout Maximum time to wait for the start of packet in microseconds. Packet that started within the timeout is received completely.
+
+      \returns \ref status_codes
+    */
+    virtual int16_t receive(uint8_t* data, size_t len, uint32_t timeout) = 0;
+
     /*!
       \brief Sets module to standby.
 
@@ -206,6 +219,22 @@ class PhysicalLayer {
    */
    virtual size_t getPacketLength(bool update = true) = 0;
 
+    /*!
+      \brief Calculates expected time-on-air of a packet with the current configuration. Must be implemented in module class.
+
+      \param len Payload length in bytes.
+
+      \returns Expected time-on-air in microseconds.
+    */
+    virtual uint32_t getTimeOnAir(size_t len) = 0;
+
+    /*!
+      \brief Gets random number, seeded from receiver noise on first use. Must be implemented in module class.
+
+      \returns Random 32-bit number.
+    */
+    virtual uint32_t random32() = 0;
+
 #ifndef RADIOLIB_GODMODE
   private:
 #endif